@@ -1,11 +1,14 @@
 #ifndef DRIVER_HEADER_H
 #define DRIVER_HEADER_H
 
+#include <string_view>
+
 #include "RegGen/RegGenInclude.h"
 
 namespace RG {
 
 using RG::BasicParser;
+using RG::ParserOptions;
 using RG::AST::ASTOptional;
 using RG::AST::ASTTypeProxyManager;
 using RG::AST::ASTVector;
@@ -237,6 +240,1505 @@ class TranslationUnit : public BasicASTObject,
   auto functions() const -> const auto& { return GetItem<0>(); }
 };
 
+// direct-coded scanner generated from the lexer automaton
+inline auto ScanToken(std::string_view data, int offset) -> BasicASTToken {
+  const char* const begin = data.data() + offset;
+  const char* const end = data.data() + data.size();
+  const char* p = begin;
+  const char* last_acc = nullptr;
+  int last_acc_token = -1;
+
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 9: case 10: goto s1;
+    case 13: goto s1;
+    case 32: goto s1;
+    case 33: goto s2;
+    case 37: goto s3;
+    case 38: goto s4;
+    case 40: goto s5;
+    case 41: goto s6;
+    case 42: goto s7;
+    case 43: goto s8;
+    case 44: goto s9;
+    case 45: goto s10;
+    case 47: goto s11;
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s12;
+    case 58: goto s13;
+    case 59: goto s14;
+    case 60: goto s15;
+    case 61: goto s16;
+    case 62: goto s17;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 94: goto s19;
+    case 95: goto s18;
+    case 97: goto s18;
+    case 98: goto s20;
+    case 99: goto s21;
+    case 100: goto s18;
+    case 101: goto s22;
+    case 102: goto s23;
+    case 103: case 104: goto s18;
+    case 105: goto s24;
+    case 106: case 107: case 108: case 109: case 110: case 111:
+    case 112: case 113: goto s18;
+    case 114: goto s25;
+    case 115: goto s18;
+    case 116: goto s26;
+    case 117: goto s27;
+    case 118: goto s28;
+    case 119: goto s29;
+    case 120: case 121: case 122: goto s18;
+    case 123: goto s30;
+    case 124: goto s31;
+    case 125: goto s32;
+    default: goto done;
+  }
+
+  s1:
+  last_acc = p;
+  last_acc_token = 41;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 9: case 10: goto s1;
+    case 13: goto s1;
+    case 32: goto s1;
+    default: goto done;
+  }
+
+  s2:
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 61: goto s33;
+    default: goto done;
+  }
+
+  s3:
+  last_acc = p;
+  last_acc_token = 7;
+  goto done;
+
+  s4:
+  last_acc = p;
+  last_acc_token = 10;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 38: goto s34;
+    default: goto done;
+  }
+
+  s5:
+  last_acc = p;
+  last_acc_token = 21;
+  goto done;
+
+  s6:
+  last_acc = p;
+  last_acc_token = 22;
+  goto done;
+
+  s7:
+  last_acc = p;
+  last_acc_token = 5;
+  goto done;
+
+  s8:
+  last_acc = p;
+  last_acc_token = 8;
+  goto done;
+
+  s9:
+  last_acc = p;
+  last_acc_token = 4;
+  goto done;
+
+  s10:
+  last_acc = p;
+  last_acc_token = 9;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 62: goto s35;
+    default: goto done;
+  }
+
+  s11:
+  last_acc = p;
+  last_acc_token = 6;
+  goto done;
+
+  s12:
+  last_acc = p;
+  last_acc_token = 40;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s12;
+    default: goto done;
+  }
+
+  s13:
+  last_acc = p;
+  last_acc_token = 2;
+  goto done;
+
+  s14:
+  last_acc = p;
+  last_acc_token = 1;
+  goto done;
+
+  s15:
+  last_acc = p;
+  last_acc_token = 15;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 61: goto s36;
+    default: goto done;
+  }
+
+  s16:
+  last_acc = p;
+  last_acc_token = 0;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 61: goto s37;
+    default: goto done;
+  }
+
+  s17:
+  last_acc = p;
+  last_acc_token = 13;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 61: goto s38;
+    default: goto done;
+  }
+
+  s18:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s19:
+  last_acc = p;
+  last_acc_token = 12;
+  goto done;
+
+  s20:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: goto s18;
+    case 111: goto s39;
+    case 112: case 113: goto s18;
+    case 114: goto s40;
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s21:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: goto s18;
+    case 111: goto s41;
+    case 112: case 113: case 114: case 115: case 116: case 117:
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s22:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107:
+      goto s18;
+    case 108: goto s42;
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s23:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: goto s43;
+    case 98: case 99: case 100: case 101: case 102: case 103:
+    case 104: case 105: case 106: case 107: case 108: case 109:
+    case 110: case 111: case 112: case 113: case 114: case 115:
+    case 116: goto s18;
+    case 117: goto s44;
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s24:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101:
+      goto s18;
+    case 102: goto s45;
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: goto s18;
+    case 110: goto s46;
+    case 111: case 112: case 113: case 114: case 115: case 116:
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s25:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: goto s18;
+    case 101: goto s47;
+    case 102: case 103: case 104: case 105: case 106: case 107:
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s26:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113:
+      goto s18;
+    case 114: goto s48;
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s27:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: goto s18;
+    case 110: goto s49;
+    case 111: case 112: case 113: case 114: case 115: case 116:
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s28:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: goto s50;
+    case 98: case 99: case 100: case 101: case 102: case 103:
+    case 104: case 105: case 106: case 107: case 108: case 109:
+    case 110: case 111: case 112: case 113: case 114: case 115:
+    case 116: case 117: case 118: case 119: case 120: case 121:
+    case 122: goto s18;
+    default: goto done;
+  }
+
+  s29:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: goto s18;
+    case 104: goto s51;
+    case 105: case 106: case 107: case 108: case 109: case 110:
+    case 111: case 112: case 113: case 114: case 115: case 116:
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s30:
+  last_acc = p;
+  last_acc_token = 23;
+  goto done;
+
+  s31:
+  last_acc = p;
+  last_acc_token = 11;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 124: goto s52;
+    default: goto done;
+  }
+
+  s32:
+  last_acc = p;
+  last_acc_token = 24;
+  goto done;
+
+  s33:
+  last_acc = p;
+  last_acc_token = 18;
+  goto done;
+
+  s34:
+  last_acc = p;
+  last_acc_token = 19;
+  goto done;
+
+  s35:
+  last_acc = p;
+  last_acc_token = 3;
+  goto done;
+
+  s36:
+  last_acc = p;
+  last_acc_token = 16;
+  goto done;
+
+  s37:
+  last_acc = p;
+  last_acc_token = 17;
+  goto done;
+
+  s38:
+  last_acc = p;
+  last_acc_token = 14;
+  goto done;
+
+  s39:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: goto s18;
+    case 111: goto s53;
+    case 112: case 113: case 114: case 115: case 116: case 117:
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s40:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: goto s18;
+    case 101: goto s54;
+    case 102: case 103: case 104: case 105: case 106: case 107:
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s41:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: goto s18;
+    case 110: goto s55;
+    case 111: case 112: case 113: case 114: case 115: case 116:
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s42:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+      goto s18;
+    case 115: goto s56;
+    case 116: case 117: case 118: case 119: case 120: case 121:
+    case 122: goto s18;
+    default: goto done;
+  }
+
+  s43:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107:
+      goto s18;
+    case 108: goto s57;
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s44:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: goto s18;
+    case 110: goto s58;
+    case 111: case 112: case 113: case 114: case 115: case 116:
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s45:
+  last_acc = p;
+  last_acc_token = 28;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s46:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: goto s18;
+    case 116: goto s59;
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s47:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: goto s18;
+    case 116: goto s60;
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s48:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: goto s18;
+    case 117: goto s61;
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s49:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: goto s18;
+    case 105: goto s62;
+    case 106: case 107: case 108: case 109: case 110: case 111:
+    case 112: case 113: case 114: case 115: case 116: case 117:
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s50:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107:
+      goto s18;
+    case 108: goto s63;
+    case 109: case 110: case 111: case 112: case 113:
+      goto s18;
+    case 114: goto s64;
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s51:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: goto s18;
+    case 105: goto s65;
+    case 106: case 107: case 108: case 109: case 110: case 111:
+    case 112: case 113: case 114: case 115: case 116: case 117:
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s52:
+  last_acc = p;
+  last_acc_token = 20;
+  goto done;
+
+  s53:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107:
+      goto s18;
+    case 108: goto s66;
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s54:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: goto s67;
+    case 98: case 99: case 100: case 101: case 102: case 103:
+    case 104: case 105: case 106: case 107: case 108: case 109:
+    case 110: case 111: case 112: case 113: case 114: case 115:
+    case 116: case 117: case 118: case 119: case 120: case 121:
+    case 122: goto s18;
+    default: goto done;
+  }
+
+  s55:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: goto s18;
+    case 116: goto s68;
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s56:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: goto s18;
+    case 101: goto s69;
+    case 102: case 103: case 104: case 105: case 106: case 107:
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s57:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+      goto s18;
+    case 115: goto s70;
+    case 116: case 117: case 118: case 119: case 120: case 121:
+    case 122: goto s18;
+    default: goto done;
+  }
+
+  s58:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: goto s18;
+    case 99: goto s71;
+    case 100: case 101: case 102: case 103: case 104: case 105:
+    case 106: case 107: case 108: case 109: case 110: case 111:
+    case 112: case 113: case 114: case 115: case 116: case 117:
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s59:
+  last_acc = p;
+  last_acc_token = 37;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s60:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: goto s18;
+    case 117: goto s72;
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s61:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: goto s18;
+    case 101: goto s73;
+    case 102: case 103: case 104: case 105: case 106: case 107:
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s62:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: goto s18;
+    case 116: goto s74;
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s63:
+  last_acc = p;
+  last_acc_token = 26;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s64:
+  last_acc = p;
+  last_acc_token = 27;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s65:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107:
+      goto s18;
+    case 108: goto s75;
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s66:
+  last_acc = p;
+  last_acc_token = 38;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s67:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: goto s18;
+    case 107: goto s76;
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s68:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: goto s18;
+    case 105: goto s77;
+    case 106: case 107: case 108: case 109: case 110: case 111:
+    case 112: case 113: case 114: case 115: case 116: case 117:
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s69:
+  last_acc = p;
+  last_acc_token = 29;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s70:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: goto s18;
+    case 101: goto s78;
+    case 102: case 103: case 104: case 105: case 106: case 107:
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s71:
+  last_acc = p;
+  last_acc_token = 25;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s72:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113:
+      goto s18;
+    case 114: goto s79;
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s73:
+  last_acc = p;
+  last_acc_token = 34;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s74:
+  last_acc = p;
+  last_acc_token = 36;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s75:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: goto s18;
+    case 101: goto s80;
+    case 102: case 103: case 104: case 105: case 106: case 107:
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s76:
+  last_acc = p;
+  last_acc_token = 31;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s77:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: goto s18;
+    case 110: goto s81;
+    case 111: case 112: case 113: case 114: case 115: case 116:
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s78:
+  last_acc = p;
+  last_acc_token = 35;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s79:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: goto s18;
+    case 110: goto s82;
+    case 111: case 112: case 113: case 114: case 115: case 116:
+    case 117: case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s80:
+  last_acc = p;
+  last_acc_token = 30;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s81:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: goto s18;
+    case 117: goto s83;
+    case 118: case 119: case 120: case 121: case 122:
+      goto s18;
+    default: goto done;
+  }
+
+  s82:
+  last_acc = p;
+  last_acc_token = 33;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s83:
+  last_acc = p;
+  last_acc_token = 39;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: goto s18;
+    case 101: goto s84;
+    case 102: case 103: case 104: case 105: case 106: case 107:
+    case 108: case 109: case 110: case 111: case 112: case 113:
+    case 114: case 115: case 116: case 117: case 118: case 119:
+    case 120: case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  s84:
+  last_acc = p;
+  last_acc_token = 32;
+  if (p == end) goto done;
+  switch (static_cast<unsigned char>(*p++)) {
+    case 48: case 49: case 50: case 51: case 52: case 53:
+    case 54: case 55: case 56: case 57: goto s18;
+    case 65: case 66: case 67: case 68: case 69: case 70:
+    case 71: case 72: case 73: case 74: case 75: case 76:
+    case 77: case 78: case 79: case 80: case 81: case 82:
+    case 83: case 84: case 85: case 86: case 87: case 88:
+    case 89: case 90: goto s18;
+    case 95: goto s18;
+    case 97: case 98: case 99: case 100: case 101: case 102:
+    case 103: case 104: case 105: case 106: case 107: case 108:
+    case 109: case 110: case 111: case 112: case 113: case 114:
+    case 115: case 116: case 117: case 118: case 119: case 120:
+    case 121: case 122: goto s18;
+    default: goto done;
+  }
+
+  done:
+  if (last_acc == nullptr) {
+    return BasicASTToken{};
+  }
+  return BasicASTToken{offset, static_cast<int>(last_acc - begin),
+                       last_acc_token};
+}
+
 inline auto CreateParser() -> BasicParser<TranslationUnit>::Ptr {
   static const auto* const config =
       u8R"##########(
@@ -666,7 +2168,9 @@ rule TranslationUnit : TranslationUnit
     return env;
   }();
 
-  return BasicParser<TranslationUnit>::Create(config, &proxy_manager);
+  ParserOptions options;
+  options.scanner = &ScanToken;
+  return BasicParser<TranslationUnit>::Create(config, &proxy_manager, options);
 }
 
 }  // namespace RG
@@ -0,0 +1,145 @@
+#include "RegGen/Container/FlatSet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// set operations of FlatSet, done in bulk versus one element at a time
+
+namespace {
+
+using RG::FlatSet;
+
+constexpr int kRepeat = 5;
+
+// best of kRepeat runs in milliseconds
+template <typename F>
+auto Measure(F body) -> double {
+  auto best = 1e30;
+  for (int i = 0; i < kRepeat; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    best = std::min(
+        best, std::chrono::duration<double, std::milli>(elapsed).count());
+  }
+
+  return best;
+}
+
+auto RandomValues(std::mt19937& rng, int n, int range) -> std::vector<int> {
+  std::uniform_int_distribution<int> dist{0, range - 1};
+
+  std::vector<int> result(n);
+  for (auto& x : result) {
+    x = dist(rng);
+  }
+
+  return result;
+}
+
+auto Report(const char* name, int n, double one_by_one, double bulk) -> void {
+  std::printf("%-12s n=%-7d one by one %9.3f ms  bulk %9.3f ms  x%.1f\n",
+              name, n, one_by_one, bulk, one_by_one / bulk);
+}
+
+auto BenchUnion(std::mt19937& rng, int n, int rounds) -> void {
+  // accumulate many small sets into one, as closure computations do
+  std::vector<FlatSet<int>> sources;
+  for (int i = 0; i < rounds; ++i) {
+    auto values = RandomValues(rng, n, n * 4);
+    sources.emplace_back(values.begin(), values.end());
+  }
+
+  size_t checksum[2] = {};
+  auto one_by_one = Measure([&] {
+    FlatSet<int> result;
+    for (const auto& source : sources) {
+      for (auto x : source) {
+        result.insert(x);
+      }
+    }
+    checksum[0] = result.size();
+  });
+  auto bulk = Measure([&] {
+    FlatSet<int> result;
+    for (const auto& source : sources) {
+      result.unite(source);
+    }
+    checksum[1] = result.size();
+  });
+
+  if (checksum[0] != checksum[1]) {
+    std::printf("union mismatch\n");
+  }
+  Report("union", n, one_by_one, bulk);
+}
+
+auto BenchConstruct(std::mt19937& rng, int n) -> void {
+  auto values = RandomValues(rng, n, n);
+
+  size_t checksum[2] = {};
+  auto one_by_one = Measure([&] {
+    FlatSet<int> result;
+    for (auto x : values) {
+      result.insert(x);
+    }
+    checksum[0] = result.size();
+  });
+  auto bulk = Measure([&] {
+    FlatSet<int> result{values.begin(), values.end()};
+    checksum[1] = result.size();
+  });
+
+  if (checksum[0] != checksum[1]) {
+    std::printf("construct mismatch\n");
+  }
+  Report("construct", n, one_by_one, bulk);
+}
+
+auto BenchDifference(std::mt19937& rng, int n) -> void {
+  auto lhs_values = RandomValues(rng, n, n * 2);
+  auto rhs_values = RandomValues(rng, n, n * 2);
+  const FlatSet<int> lhs{lhs_values.begin(), lhs_values.end()};
+  const FlatSet<int> rhs{rhs_values.begin(), rhs_values.end()};
+
+  size_t checksum[2] = {};
+  auto one_by_one = Measure([&] {
+    auto result = lhs;
+    for (auto x : rhs) {
+      result.erase(x);
+    }
+    checksum[0] = result.size();
+  });
+  auto bulk = Measure([&] {
+    auto result = lhs;
+    result.subtract(rhs);
+    checksum[1] = result.size();
+  });
+
+  if (checksum[0] != checksum[1]) {
+    std::printf("difference mismatch\n");
+  }
+  Report("difference", n, one_by_one, bulk);
+}
+
+}  // namespace
+
+auto main() -> int {
+  std::mt19937 rng{42};
+
+  for (auto n : {16, 256, 4096}) {
+    BenchUnion(rng, n, 256);
+  }
+  for (auto n : {256, 4096, 65536}) {
+    BenchConstruct(rng, n);
+  }
+  for (auto n : {256, 4096, 65536}) {
+    BenchDifference(rng, n);
+  }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "Header.h"
+
+// parsing the sample language of lang_define.txt with its generated scanner,
+// per token the parser reads, so that the cost of the parsing loop shows
+// apart from that of scanning
+
+namespace {
+
+constexpr int kRepeat = 7;
+
+// best of kRepeat runs in milliseconds
+template <typename F>
+auto Measure(F body) -> double {
+  auto best = 1e30;
+  for (int i = 0; i < kRepeat; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    best = std::min(
+        best, std::chrono::duration<double, std::milli>(elapsed).count());
+  }
+
+  return best;
+}
+
+// about size bytes of functions using every kind of statement
+auto GenerateInput(int size) -> std::string {
+  std::string result;
+  for (int i = 0; result.size() < size; ++i) {
+    result += "func f" + std::to_string(i) +
+              "(x: int, y: int, z: bool) -> int {\n"
+              "  val a: int = x * 2 + y % 7;\n"
+              "  var b: bool = a >= 0 && z || y != 3;\n"
+              "  while (b) if (a - 1 < x) break; else continue;\n"
+              "  if (x <= y) { return a + x * (y - 1); }\n"
+              "  return (a | 5) & 7;\n"
+              "}\n";
+  }
+
+  return result;
+}
+
+auto Report(const char* name, double ms, int token_num) -> void {
+  std::printf("%-8s %9.3f ms  %6.1f ns/token\n", name, ms,
+              ms * 1e6 / token_num);
+}
+
+}  // namespace
+
+auto main() -> int {
+  const auto text = GenerateInput(1 << 21);
+  auto parser = RG::CreateParser();
+
+  const auto token_num =
+      parser->Tokenize(text, RG::TokenFilter::Significant).Size();
+  std::printf("%zu bytes, %d parser tokens\n", text.size(), token_num);
+
+  // the scanner alone, ignored tokens included
+  auto checksum = 0;
+  auto scan = Measure([&] {
+    checksum = 0;
+    for (int offset = 0; offset < text.size();) {
+      auto tok = RG::ScanToken(text, offset);
+      offset = tok.Offset() + tok.Length();
+      checksum += tok.Tag();
+    }
+  });
+
+  // scanning, parsing and building the ast
+  auto functions = 0;
+  auto parse = Measure([&] {
+    RG::Arena arena;
+    functions = parser->Parse(arena, text)->functions()->Size();
+  });
+
+  // parsing and building the ast from a prebuilt token buffer
+  const auto tokens = parser->Tokenize(text, RG::TokenFilter::Significant);
+  auto parse_tokens = Measure([&] {
+    RG::Arena arena;
+    functions = parser->Parse(arena, tokens)->functions()->Size();
+  });
+
+  if (checksum == 0 || functions == 0) {
+    std::printf("nothing parsed\n");
+  }
+  Report("scan", scan, token_num);
+  Report("parse", parse, token_num);
+  Report("prebuilt", parse_tokens, token_num);
+
+  return 0;
+}
@@ -1,7 +1,9 @@
 #ifndef REGGEN_AST_AST_HANDLE_H
 #define REGGEN_AST_AST_HANDLE_H
 
+#include <string>
 #include <string_view>
+#include <utility>
 #include <variant>
 
 #include "RegGen/AST/ASTBasic.h"
@@ -17,6 +19,8 @@ class ASTEnumGen {
  public:
   ASTEnumGen(int value) : value_(value) {}
 
+  auto Value() const -> int { return value_; }
+
   auto Invoke(const ASTTypeProxy& proxy, Arena& /*arena*/,
               ArrayRef<ASTItem> /*rhs*/) const -> ASTItem {
     return proxy.ConstructEnum(value_);
@@ -54,6 +58,8 @@ class ASTItemSelector {
  public:
   ASTItemSelector(int index) : index_(index) {}
 
+  auto Index() const -> int { return index_; }
+
   auto Invoke(const ASTTypeProxy& /*proxy*/, Arena& /*arena*/,
               ArrayRef<ASTItem> rhs) const -> ASTItem {
     assert(index_ < rhs.size());
@@ -80,6 +86,8 @@ class ASTObjectSetter {
   ASTObjectSetter(const SmallVector<SetterPair>& setters)
       : setters_(setters) {}
 
+  auto Setters() const -> const auto& { return setters_; }
+
   void Invoke(const ASTTypeProxy& proxy, ASTItem obj,
               ArrayRef<ASTItem> rhs) const {
     for (auto setter : setters_) {
@@ -96,6 +104,8 @@ class ASTVectorMerger {
   ASTVectorMerger(const SmallVector<int>& indices)
       : indices_(indices) {}
 
+  auto Indices() const -> const auto& { return indices_; }
+
   void Invoke(const ASTTypeProxy& proxy, ASTItem vec,
               ArrayRef<ASTItem> rhs) const {
     for (auto index : indices_) {
@@ -115,8 +125,18 @@ class ASTHandle {
   using ManipHandle =
       std::variant<ASTManipPlaceholder, ASTObjectSetter, ASTVectorMerger>;
 
-  ASTHandle(const ASTTypeProxy* proxy, GenHandle gen, ManipHandle manip)
-      : proxy_(proxy), gen_handle_(gen), manip_handle_(manip) {}
+  ASTHandle(std::string type_name, const ASTTypeProxy* proxy, GenHandle gen,
+            ManipHandle manip)
+      : type_name_(std::move(type_name)),
+        proxy_(proxy),
+        gen_handle_(gen),
+        manip_handle_(manip) {}
+
+  // name of the type that proxy_ was looked up with
+  auto TypeName() const -> const auto& { return type_name_; }
+
+  auto Generator() const -> const auto& { return gen_handle_; }
+  auto Manipulator() const -> const auto& { return manip_handle_; }
 
   auto Invoke(Arena& arena, ArrayRef<ASTItem> rhs) const -> ASTItem {
     auto gen_visitor = [&](const auto& gen) {
@@ -129,6 +149,11 @@ class ASTHandle {
     };
     std::visit(manip_visitor, manip_handle_);
 
+    // an epsilon production has no location to take
+    if (rhs.empty()) {
+      return result;
+    }
+
     auto front_loc = const_cast<ASTItem&>(rhs.front()).GetLocationInfo();
     auto back_loc = const_cast<ASTItem&>(rhs.back()).GetLocationInfo();
 
@@ -140,6 +165,7 @@ class ASTHandle {
   }
 
  private:
+  std::string type_name_;
   const ASTTypeProxy* proxy_;
 
   GenHandle gen_handle_;
@@ -0,0 +1,112 @@
+#ifndef REGGEN_COMMON_BINARY_STREAM_H
+#define REGGEN_COMMON_BINARY_STREAM_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "RegGen/Common/Error.h"
+
+namespace RG {
+
+// FNV-1a over bytes
+inline auto ComputeChecksum(std::string_view data) -> uint64_t {
+  uint64_t result = 14695981039346656037ULL;
+  for (auto ch : data) {
+    result ^= static_cast<uint8_t>(ch);
+    result *= 1099511628211ULL;
+  }
+  return result;
+}
+
+// appends values in native byte order to a buffer
+class BinaryWriter {
+ public:
+  auto Buffer() const -> const std::string& { return buffer_; }
+
+  auto WriteBytes(const void* data, size_t size) -> void {
+    buffer_.append(static_cast<const char*>(data), size);
+  }
+
+  auto WriteInt(int32_t value) -> void { WriteBytes(&value, sizeof(value)); }
+
+  auto WriteString(std::string_view s) -> void {
+    WriteInt(static_cast<int32_t>(s.size()));
+    WriteBytes(s.data(), s.size());
+  }
+
+  template <typename T>
+  auto WriteArray(const T* data, int size) -> void {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    WriteInt(size);
+    WriteBytes(data, sizeof(T) * size);
+  }
+
+ private:
+  std::string buffer_;
+};
+
+// reads values written by BinaryWriter, throws on truncated data
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string_view data) : data_(data) {}
+
+  auto Exhausted() const -> bool { return offset_ == data_.size(); }
+
+  auto ReadBytes(void* dest, size_t size) -> void {
+    Require(size);
+    std::memcpy(dest, data_.data() + offset_, size);
+    offset_ += size;
+  }
+
+  auto ReadInt() -> int32_t {
+    int32_t result;
+    ReadBytes(&result, sizeof(result));
+    return result;
+  }
+
+  // reads a non-negative int no greater than limit
+  auto ReadCount(int limit) -> int {
+    auto result = ReadInt();
+    if (result < 0 || result > limit) {
+      throw ParserConstructionError{"BinaryReader: invalid count"};
+    }
+    return result;
+  }
+
+  auto ReadString() -> std::string {
+    auto size = ReadCount(static_cast<int>(data_.size() - offset_));
+
+    auto result = std::string(data_.substr(offset_, size));
+    offset_ += size;
+    return result;
+  }
+
+  // reads an array of exactly size elements into dest
+  template <typename T>
+  auto ReadArray(T* dest, int size) -> void {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    if (ReadInt() != size) {
+      throw ParserConstructionError{"BinaryReader: unexpected array size"};
+    }
+    ReadBytes(dest, sizeof(T) * size);
+  }
+
+ private:
+  auto Require(size_t size) const -> void {
+    if (data_.size() - offset_ < size) {
+      throw ParserConstructionError{"BinaryReader: unexpected end of data"};
+    }
+  }
+
+  std::string_view data_;
+  size_t offset_ = 0;
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_COMMON_BINARY_STREAM_H
@@ -12,6 +12,7 @@ struct ParserConfiguration {
   SmallVector<NodeDefinition> nodes;
   SmallVector<RuleDefinition> rules;
   SmallVector<BaseDefinition> bases;
+  SmallVector<PrecedenceDefinition> precedences;
 };
 
 auto ParseConfig(const std::string& data)
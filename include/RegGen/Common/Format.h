@@ -1,6 +1,7 @@
 #ifndef REGGEX_COMMON_FORMAT_H
 #define REGGEX_COMMON_FORMAT_H
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
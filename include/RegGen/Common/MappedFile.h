@@ -0,0 +1,30 @@
+#ifndef REGGEN_COMMON_MAPPED_FILE_H
+#define REGGEN_COMMON_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "RegGen/Common/InheritRestrict.h"
+
+namespace RG {
+
+// read-only memory mapping of a whole file
+class MappedFile : NonCopyable, NonMovable {
+ public:
+  // throws ParserConstructionError if the file cannot be mapped
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  auto Data() const -> std::string_view {
+    return {static_cast<const char*>(data_), size_};
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_COMMON_MAPPED_FILE_H
@@ -0,0 +1,88 @@
+#ifndef REGGEN_COMMON_THREAD_POOL_H
+#define REGGEN_COMMON_THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RegGen/Common/InheritRestrict.h"
+
+namespace RG {
+
+// fixed set of worker threads, each owning a deque of tasks
+//
+// a worker pops tasks from the back of its own deque and steals from the front
+// of the others when it runs dry. tasks submitted from a worker go to its own
+// deque, tasks from other threads are dealt round-robin
+class ThreadPool : NonCopyable, NonMovable {
+ public:
+  // 0 means one worker per hardware thread
+  explicit ThreadPool(int thread_num = 0);
+  ~ThreadPool();
+
+  auto ThreadCount() const -> int { return workers_.size(); }
+
+  auto Submit(std::function<void()> task) -> std::future<void>;
+
+  // invokes body(i) for every i in [0, n) and returns when all are done, the
+  // calling thread takes indices as well so that nested calls cannot deadlock
+  //
+  // the first exception thrown by body is rethrown, indices not yet started
+  // are then skipped
+  auto ParallelFor(int n, const std::function<void(int)>& body) -> void;
+
+ private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  auto Push(std::function<void()> task) -> void;
+  auto TryPop(int worker, std::function<void()>& task) -> bool;
+  auto WorkerLoop(int worker) -> void;
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  // tasks pushed but not yet popped
+  std::atomic<int> pending_ = 0;
+  std::atomic<unsigned> next_queue_ = 0;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+// blocks on cond until pred holds, without waking up in between
+//
+// GCC 12 binds condition_variable::wait to a GLIBCXX_3.4.30 symbol that older
+// runtimes cannot load, while wait_until on steady_clock is inline. waiting
+// for a deadline that never comes blocks the same way
+template <typename Pred>
+inline auto BlockUntil(std::condition_variable& cond,
+                       std::unique_lock<std::mutex>& lock, Pred pred) -> void {
+  cond.wait_until(lock, std::chrono::steady_clock::time_point::max(), pred);
+}
+
+// ParallelFor on pool, or a plain loop if pool is nullptr
+inline auto ParallelFor(ThreadPool* pool, int n,
+                        const std::function<void(int)>& body) -> void {
+  if (pool == nullptr) {
+    for (int i = 0; i < n; ++i) {
+      body(i);
+    }
+  } else {
+    pool->ParallelFor(n, body);
+  }
+}
+
+}  // namespace RG
+
+#endif  // REGGEN_COMMON_THREAD_POOL_H
@@ -50,6 +50,9 @@ struct RuleSymbol {
 struct RuleItem {
   SmallVector<RuleSymbol> rhs;
   std::optional<QualType> class_hint;
+
+  // token named by %prec, empty if not given
+  std::string precedence;
 };
 
 struct RuleDefinition {
@@ -59,6 +62,12 @@ struct RuleDefinition {
   SmallVector<RuleItem, 0> items;
 };
 
+// one %left, %right or %nonassoc line, later lines bind tighter
+struct PrecedenceDefinition {
+  std::string assoc;  // "left", "right" or "nonassoc"
+  SmallVector<std::string> tokens;
+};
+
 }  // namespace RG
 
 #endif  // REGGEN_COMMON_TYPE_DEFINITION_H
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef REGGEN_CONTAINER_BITSET_H
+#define REGGEN_CONTAINER_BITSET_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "RegGen/Container/SmallVector.h"
+
+namespace RG {
+
+// dynamically sized bitset, bits are packed into machine words
+//
+// bulk operations are plain loops over words, so that the compiler is free to
+// vectorize them
+class Bitset {
+ public:
+  using word_type = uint64_t;
+
+  static constexpr int kWordBits = 64;
+  static constexpr int npos = -1;
+
+  struct Hash {
+    auto operator()(const Bitset& bits) const -> size_t { return bits.hash(); }
+  };
+
+  Bitset() = default;
+  explicit Bitset(int size) { resize(size); }
+
+  auto size() const noexcept -> int { return size_; }
+  auto word_count() const noexcept -> int { return words_.size(); }
+
+  auto data() const noexcept -> const word_type* { return words_.data(); }
+  auto data() noexcept -> word_type* { return words_.data(); }
+
+  auto resize(int size) -> void {
+    assert(size >= 0);
+    size_ = size;
+    words_.resize((size + kWordBits - 1) / kWordBits, 0);
+
+    // clear bits beyond size
+    if (auto tail = size % kWordBits; tail != 0) {
+      words_.back() &= (word_type{1} << tail) - 1;
+    }
+  }
+
+  auto test(int pos) const -> bool {
+    assert(pos >= 0 && pos < size_);
+    return (words_[pos / kWordBits] >> (pos % kWordBits)) & 1;
+  }
+
+  auto set(int pos) -> void {
+    assert(pos >= 0 && pos < size_);
+    words_[pos / kWordBits] |= word_type{1} << (pos % kWordBits);
+  }
+
+  auto reset(int pos) -> void {
+    assert(pos >= 0 && pos < size_);
+    words_[pos / kWordBits] &= ~(word_type{1} << (pos % kWordBits));
+  }
+
+  auto clear() -> void { std::fill(words_.begin(), words_.end(), 0); }
+
+  auto any() const -> bool {
+    for (auto word : words_) {
+      if (word != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  auto none() const -> bool { return !any(); }
+
+  auto count() const -> int {
+    auto result = 0;
+    for (auto word : words_) {
+      result += __builtin_popcountll(word);
+    }
+    return result;
+  }
+
+  // merge bits of other into this set, returns if any bit is newly set
+  auto unite(const Bitset& other) -> bool {
+    assert(size_ == other.size_);
+
+    word_type changed = 0;
+    for (int i = 0; i < words_.size(); ++i) {
+      auto merged = words_[i] | other.words_[i];
+      changed |= merged ^ words_[i];
+      words_[i] = merged;
+    }
+    return changed != 0;
+  }
+
+  // returns if this set shares any bit with other
+  auto intersects(const Bitset& other) const -> bool {
+    assert(size_ == other.size_);
+
+    for (int i = 0; i < words_.size(); ++i) {
+      if ((words_[i] & other.words_[i]) != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  auto operator|=(const Bitset& other) -> Bitset& {
+    assert(size_ == other.size_);
+
+    for (int i = 0; i < words_.size(); ++i) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+
+  auto operator&=(const Bitset& other) -> Bitset& {
+    assert(size_ == other.size_);
+
+    for (int i = 0; i < words_.size(); ++i) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+
+  // returns the first set bit at or after pos, or npos
+  auto find_next(int pos) const -> int {
+    if (pos >= size_) {
+      return npos;
+    }
+
+    auto index = pos / kWordBits;
+    auto word = words_[index] & (~word_type{0} << (pos % kWordBits));
+    while (word == 0) {
+      if (++index == words_.size()) {
+        return npos;
+      }
+      word = words_[index];
+    }
+
+    return index * kWordBits + __builtin_ctzll(word);
+  }
+
+  auto find_first() const -> int { return find_next(0); }
+
+  // invoke callback with index of each set bit in ascending order
+  template <typename F>
+  auto for_each(F callback) const -> void {
+    for (int i = 0; i < words_.size(); ++i) {
+      for (auto word = words_[i]; word != 0; word &= word - 1) {
+        callback(i * kWordBits + __builtin_ctzll(word));
+      }
+    }
+  }
+
+  auto hash() const -> size_t {
+    // FNV-1a over words
+    size_t result = 14695981039346656037ULL;
+    for (auto word : words_) {
+      result ^= word;
+      result *= 1099511628211ULL;
+    }
+    return result;
+  }
+
+  friend auto operator==(const Bitset& lhs, const Bitset& rhs) -> bool {
+    return lhs.size_ == rhs.size_ &&
+           std::equal(lhs.words_.begin(), lhs.words_.end(),
+                      rhs.words_.begin());
+  }
+
+  friend auto operator!=(const Bitset& lhs, const Bitset& rhs) -> bool {
+    return !(lhs == rhs);
+  }
+
+ private:
+  int size_ = 0;
+  SmallVector<word_type, 4> words_;
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_CONTAINER_BITSET_H
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <type_traits>
 #include <vector>
 
@@ -42,12 +43,12 @@ class FlatSet {
   FlatSet(InputIt first, InputIt last) {
     assign(first, last);
   }
-  FlatSet(const FlatSet& other) { assign(other.begin(), other.end()); }
+  FlatSet(const FlatSet& other) : container_(other.container_) {}
   FlatSet(FlatSet&& other) { swap(other); }
   FlatSet(std::initializer_list<Key> ilist) { assign(ilist); }
 
   auto operator=(const FlatSet& other) -> FlatSet& {
-    assign(other.begin(), other.end());
+    container_ = other.container_;
     return *this;
   }
   auto operator=(FlatSet&& other) -> FlatSet& {
@@ -58,10 +59,14 @@ class FlatSet {
 
   ~FlatSet() = default;
 
+  // elements may come in any order, they are sorted and deduplicated at once
   template <typename InputIt>
   void assign(InputIt first, InputIt last) {
-    clear();
-    insert(first, last);
+    static_assert(Constraint<InputIt>(is_iterator),
+                  "InputIt must be an iterator type");
+
+    container_.assign(first, last);
+    Normalize(container_.begin());
   }
 
   void assign(std::initializer_list<Key> ilist) {
@@ -83,19 +88,19 @@ class FlatSet {
   auto cbegin() const noexcept -> const_iterator { return container_.cbegin(); }
   auto cend() const noexcept -> const_iterator { return container_.cend(); }
 
-  auto rbegin() noexcept -> reverse_iterator { return container_.begin(); }
-  auto rend() noexcept -> reverse_iterator { return container_.end(); }
+  auto rbegin() noexcept -> reverse_iterator { return container_.rbegin(); }
+  auto rend() noexcept -> reverse_iterator { return container_.rend(); }
   auto rbegin() const noexcept -> const_reverse_iterator {
-    return container_.cbegin();
+    return container_.crbegin();
   }
   auto rend() const noexcept -> const_reverse_iterator {
-    return container_.cend();
+    return container_.crend();
   }
   auto rcbegin() const noexcept -> const_reverse_iterator {
-    return container_.cbegin();
+    return container_.crbegin();
   }
   auto rcend() const noexcept -> const_reverse_iterator {
-    return container_.cend();
+    return container_.crend();
   }
 
   auto empty() const noexcept -> bool { return container_.empty(); }
@@ -104,6 +109,7 @@ class FlatSet {
   auto max_size() const noexcept -> size_type { return container_.max_size(); }
 
   void clear() { container_.clear(); }
+  void reserve(size_type n) { container_.reserve(n); }
 
   template <typename... TArgs>
   auto emplace(TArgs&&... args) -> std::pair<iterator, bool> {
@@ -114,8 +120,8 @@ class FlatSet {
     if (lb != container_.end() && !key_comp()(value, *lb)) {
       return std::make_pair(lb, false);
     } else {
-      iterator where = container_.emplace(lb, std::forward<TArgs>(args)...);
-      return std::make_pair(lb, false);
+      iterator where = container_.insert(lb, std::move(value));
+      return std::make_pair(where, true);
     }
   }
   auto insert(const value_type& value) -> std::pair<iterator, bool> {
@@ -125,19 +131,27 @@ class FlatSet {
     return emplace(std::forward<value_type>(value));
   }
   auto insert(const_iterator hint, const value_type& value) -> iterator {
-    (void)hint;
-    return emplace(value);
+    return insert(hint, value_type{value});
   }
   auto insert(const_iterator hint, value_type&& value) -> iterator {
-    (void)hint;
-    return emplace(std::forward<value_type>(value));
+    // value belongs right before hint, no need to search
+    if ((hint == cbegin() || key_comp()(*std::prev(hint), value)) &&
+        (hint == cend() || key_comp()(value, *hint))) {
+      return container_.insert(hint, std::forward<value_type>(value));
+    }
+
+    return emplace(std::forward<value_type>(value)).first;
   }
   template <typename InputIt>
   void insert(InputIt first, InputIt last) {
     static_assert(Constraint<InputIt>(is_iterator),
                   "InputIt must be an iterator type");
 
-    std::for_each(first, last, [&](const auto& elem) { insert(elem); });
+    // append, then merge the sorted tail in, rather than shifting the
+    // elements for each insertion
+    const auto old_size = container_.size();
+    container_.insert(container_.end(), first, last);
+    Normalize(container_.begin() + old_size);
   }
   void insert(std::initializer_list<value_type> ilist) {
     insert(ilist.begin(), ilist.end());
@@ -152,6 +166,47 @@ class FlatSet {
 
   void swap(FlatSet& other) { container_.swap(other.container_); }
 
+  // set algebra in a single pass over both sides, each returns if this set
+  // was changed
+
+  // merge elements of a sorted range into this set
+  template <typename InputIt>
+  auto unite(InputIt first, InputIt last) -> bool {
+    if (first == last) {
+      return false;
+    }
+
+    underlying_container result;
+    result.reserve(container_.size() + std::distance(first, last));
+    std::set_union(container_.begin(), container_.end(), first, last,
+                   std::back_inserter(result), key_comp());
+
+    return Replace(result);
+  }
+  auto unite(const FlatSet& other) -> bool {
+    return unite(other.begin(), other.end());
+  }
+
+  auto intersect(const FlatSet& other) -> bool { return Filter(other, true); }
+  auto subtract(const FlatSet& other) -> bool { return Filter(other, false); }
+
+  // returns if this set shares any element with other
+  auto intersects(const FlatSet& other) const -> bool {
+    auto lhs = begin();
+    auto rhs = other.begin();
+    while (lhs != end() && rhs != other.end()) {
+      if (key_comp()(*lhs, *rhs)) {
+        ++lhs;
+      } else if (key_comp()(*rhs, *lhs)) {
+        ++rhs;
+      } else {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
   auto count(const Key& value) const -> size_type {
     return find(value) == end() ? 0 : 1;
   }
@@ -184,6 +239,55 @@ class FlatSet {
   auto value_comp() const -> value_compare { return value_compare{}; }
 
  private:
+  // restore order after elements were appended from tail on, the sorted
+  // prefix wins over equal elements of the tail
+  void Normalize(iterator tail) {
+    if (!std::is_sorted(tail, container_.end(), key_comp())) {
+      std::stable_sort(tail, container_.end(), key_comp());
+    }
+    std::inplace_merge(container_.begin(), tail, container_.end(),
+                       key_comp());
+
+    // NOTE sorted, so a == b <=> !(a < b)
+    const auto end = std::unique(
+        container_.begin(), container_.end(),
+        [&](const Key& a, const Key& b) { return !key_comp()(a, b); });
+    container_.erase(end, container_.end());
+  }
+
+  auto Replace(underlying_container& result) -> bool {
+    const auto changed = result.size() != container_.size();
+    if (changed) {
+      container_.swap(result);
+    }
+
+    return changed;
+  }
+
+  // keep the elements that are, or are not, in other
+  auto Filter(const FlatSet& other, bool common) -> bool {
+    auto out = container_.begin();
+    auto rhs = other.begin();
+    for (auto it = container_.begin(); it != container_.end(); ++it) {
+      while (rhs != other.end() && key_comp()(*rhs, *it)) {
+        ++rhs;
+      }
+
+      const auto found = rhs != other.end() && !key_comp()(*it, *rhs);
+      if (found == common) {
+        if (out != it) {
+          *out = std::move(*it);
+        }
+        ++out;
+      }
+    }
+
+    const auto changed = out != container_.end();
+    container_.erase(out, container_.end());
+
+    return changed;
+  }
+
   std::vector<Key, Allocator> container_;
 };
 
@@ -24,6 +24,7 @@ class HeapArray : NonCopyable {
   auto operator=(HeapArray&& other) -> HeapArray& {
     initialize(0);
     this->swap(other);
+    return *this;
   }
 
   ~HeapArray() { Destroy(); }
@@ -47,7 +48,9 @@ class HeapArray : NonCopyable {
     return ptr_[index];
   }
 
-  auto ref() -> ArrayRef<T> { return ArrayRef<T>{ptr_, size_}; }
+  auto ref() -> ArrayRef<T> {
+    return ArrayRef<T>{ptr_, static_cast<size_t>(size_)};
+  }
 
   auto initialize(int len) -> void {
     InitializeInternal(
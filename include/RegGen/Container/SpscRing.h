@@ -0,0 +1,98 @@
+#ifndef REGGEN_CONTAINER_SPSC_RING_H
+#define REGGEN_CONTAINER_SPSC_RING_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+#include "RegGen/Common/InheritRestrict.h"
+#include "RegGen/Container/HeapArray.h"
+
+namespace RG {
+
+// bounded lock-free queue between exactly one producer and one consumer
+// thread
+//
+// slots are preallocated and filled in place, the producer writes the slot
+// returned by Back and publishes it with Push, the consumer reads the slot
+// returned by Front and gives it back with Pop. neither call blocks, a full
+// or empty ring yields nullptr and the caller decides how to wait
+template <typename T>
+class SpscRing : NonCopyable, NonMovable {
+ public:
+  // capacity is rounded up to a power of two
+  explicit SpscRing(int capacity) {
+    assert(capacity > 0);
+
+    auto size = 1;
+    while (size < capacity) {
+      size *= 2;
+    }
+
+    slots_.initialize(size);
+    mask_ = size - 1;
+  }
+
+  auto Capacity() const -> int { return mask_ + 1; }
+
+  // producer side
+
+  // slot to fill next, or nullptr if the ring is full
+  auto Back() -> T* {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ > mask_) {
+        return nullptr;
+      }
+    }
+
+    return &slots_[tail & mask_];
+  }
+
+  // publishes the slot returned by Back
+  auto Push() -> void {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // consumer side
+
+  // oldest published slot, or nullptr if the ring is empty
+  auto Front() -> T* {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return nullptr;
+      }
+    }
+
+    return &slots_[head & mask_];
+  }
+
+  // hands the slot returned by Front back to the producer
+  auto Pop() -> void {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+ private:
+  // keeps the indices of the two threads on separate cache lines
+  static constexpr size_t kCacheLineSize = 64;
+
+  HeapArray<T> slots_;
+  size_t mask_;
+
+  // consumer: next slot to read, and the last tail_ it saw
+  alignas(kCacheLineSize) std::atomic<size_t> head_ = 0;
+  size_t cached_tail_ = 0;
+
+  // producer: next slot to write, and the last head_ it saw
+  alignas(kCacheLineSize) std::atomic<size_t> tail_ = 0;
+  size_t cached_head_ = 0;
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_CONTAINER_SPSC_RING_H
@@ -0,0 +1,51 @@
+#ifndef REGGEN_LEXER_BIT_PARALLEL_NFA_H
+#define REGGEN_LEXER_BIT_PARALLEL_NFA_H
+
+#include <cassert>
+
+#include "RegGen/Common/InheritRestrict.h"
+#include "RegGen/Container/Bitset.h"
+#include "RegGen/Container/SmallVector.h"
+#include "RegGen/Lexer/PositionAutomaton.h"
+
+namespace RG {
+
+// simulates a position automaton without determinization
+//
+// a state is the bitset of positions that may consume the next char. as every
+// edge into a glushkov position carries the label of that position, a step is
+// D' = Follow(D & B[c]), where B[c] is the class mask of c. Follow is looked up
+// kChunkBits positions at a time in precomputed tables, so a step costs
+// O(positions / kChunkBits) bitset unions regardless of the regex structure
+class BitParallelNfa : NonCopyable, NonMovable {
+ public:
+  static constexpr int kChunkBits = 4;
+  static constexpr int kChunkSize = 1 << kChunkBits;
+
+  explicit BitParallelNfa(const PositionAutomaton* pa);
+
+  auto PositionCount() const -> int { return pa_->PositionCount(); }
+
+  auto InitialState() const -> const Bitset& { return pa_->initial; }
+
+  // writes into dest the positions reached from src on ch
+  auto Transit(const Bitset& src, char ch, Bitset& dest) const -> void;
+
+  auto AcceptedToken(const Bitset& state) const -> const TokenInfo* {
+    if (!state.intersects(pa_->accept_mask)) {
+      return nullptr;
+    }
+
+    return pa_->ComputeAcceptCategory(state);
+  }
+
+ private:
+  const PositionAutomaton* pa_;
+
+  // union of follow_pos of each subset of a chunk, kChunkSize rows per chunk
+  SmallVector<Bitset> follow_table_ = {};
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_LEXER_BIT_PARALLEL_NFA_H
@@ -0,0 +1,60 @@
+#ifndef REGGEN_LEXER_LAZY_DFA_H
+#define REGGEN_LEXER_LAZY_DFA_H
+
+#include <cassert>
+#include <unordered_map>
+
+#include "RegGen/Common/InheritRestrict.h"
+#include "RegGen/Container/Bitset.h"
+#include "RegGen/Container/SmallVector.h"
+#include "RegGen/Lexer/PositionAutomaton.h"
+
+namespace RG {
+
+// dfa over a position automaton whose states and transitions are computed on
+// first use
+//
+// at most cache_capacity states are kept, the cache is flushed when it is full.
+// ids returned before a flush are invalidated, except the initial state which
+// is always 0
+class LazyDfa : NonCopyable, NonMovable {
+ public:
+  static constexpr int kDeadState = -1;
+
+  LazyDfa(const PositionAutomaton* pa, int cache_capacity);
+
+  auto CharClasses() const -> const CharClassMap& { return pa_->char_classes; }
+
+  auto InitialState() const -> int { return 0; }
+
+  // returns target state of state on ch, or kDeadState if no token may match
+  auto Transit(int state, char ch) -> int;
+
+  auto AcceptedToken(int state) const -> const TokenInfo* {
+    assert(state >= 0 && state < CachedStateCount());
+    return acc_token_[state];
+  }
+
+  auto CachedStateCount() const -> int { return states_.size(); }
+  auto FlushCount() const -> int { return flush_count_; }
+
+ private:
+  static constexpr int kUnknownState = -2;
+
+  auto InternState(Bitset set) -> int;
+  auto Flush() -> void;
+
+  const PositionAutomaton* pa_;
+  int class_num_;
+  int cache_capacity_;
+  int flush_count_ = 0;
+
+  SmallVector<Bitset> states_ = {};
+  SmallVector<const TokenInfo*> acc_token_ = {};
+  SmallVector<int> transitions_ = {};  // class_num_ columns per state
+  std::unordered_map<Bitset, int, Bitset::Hash> state_lookup_ = {};
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_LEXER_LAZY_DFA_H
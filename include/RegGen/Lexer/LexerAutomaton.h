@@ -1,28 +1,58 @@
 #ifndef REGGEN_LEXER_LEXER_AUTOMATON_H
 #define REGGEN_LEXER_LEXER_AUTOMATON_H
 
+#include <algorithm>
 #include <functional>
 #include <optional>
 
+#include "RegGen/Lexer/PositionAutomaton.h"
 #include "RegGen/Lexer/Regex.h"
 #include "RegGen/Parser/TypeInfo.h"
 
 namespace RG {
 
+struct DfaState;
+
+struct DfaTransition {
+  CharRange range;
+  DfaState* target;
+};
+
 struct DfaState {
   int id;
   const TokenInfo* acc_token;
-  std::unordered_map<int, DfaState*> transitions;
+
+  // disjoint edges sorted by character range
+  SmallVector<DfaTransition> transitions;
 
  public:
   DfaState(int id, const TokenInfo* acc_token = nullptr)
       : id(id), acc_token(acc_token) {}
+
+  auto LookupTransition(int ch) const -> DfaState* {
+    auto it = std::upper_bound(
+        transitions.begin(), transitions.end(), ch,
+        [](int ch, const DfaTransition& edge) { return ch < edge.range.Min(); });
+
+    if (it == transitions.begin() || !std::prev(it)->range.Contain(ch)) {
+      return nullptr;
+    }
+
+    return std::prev(it)->target;
+  }
 };
 
 class LexerAutomaton : NonCopyable, NonMovable {
  public:
+  auto CharClasses() const -> const auto& { return char_classes_; }
+
   auto StateCount() const -> int { return states_.size(); }
 
+  // number of states before minimization
+  auto UnminimizedStateCount() const -> int {
+    return unminimized_state_count_ ? unminimized_state_count_ : StateCount();
+  }
+
   auto LookupState(int id) const -> const DfaState* {
     return states_.at(id).get();
   }
@@ -34,16 +64,48 @@ class LexerAutomaton : NonCopyable, NonMovable {
         .get();
   }
 
-  auto NewTransition(DfaState* src, DfaState* target, int ch) -> void {
-    assert(ch >= 0 && ch < 128);
-    assert(src->transitions.count(ch) == 0);
-    src->transitions.insert_or_assign(ch, target);
+  // edges of a state must be added in ascending order of character
+  auto NewTransition(DfaState* src, DfaState* target, CharRange rg) -> void {
+    assert(rg.Min() >= 0 && rg.Max() < CharClassMap::kAlphabetSize);
+    assert(src->transitions.empty() ||
+           src->transitions.back().range.Max() < rg.Min());
+
+    // merge with the previous edge if adjacent and of the same target
+    if (!src->transitions.empty()) {
+      auto& last = src->transitions.back();
+      if (last.target == target && last.range.Max() + 1 == rg.Min()) {
+        last.range = CharRange{last.range.Min(), rg.Max()};
+        return;
+      }
+    }
+
+    src->transitions.push_back({rg, target});
+  }
+
+  auto SetUnminimizedStateCount(int count) -> void {
+    unminimized_state_count_ = count;
+  }
+
+  auto SetCharClasses(const CharClassMap& classes) -> void {
+    char_classes_ = classes;
   }
 
  private:
+  CharClassMap char_classes_;
+
+  int unminimized_state_count_ = 0;
   SmallVector<std::unique_ptr<DfaState>> states_;
 };
 
+class ThreadPool;
+
+// returns nullptr if determinization needs more than state_limit states,
+// a state_limit of 0 means no limit
+//
+// if pool is set, subset construction runs on it, the automaton is the same
+auto BuildLexerAutomaton(const PositionAutomaton& pa, int state_limit = 0,
+                         ThreadPool* pool = nullptr)
+    -> std::unique_ptr<const LexerAutomaton>;
 auto BuildLexerAutomaton(const MetaInfo& info)
     -> std::unique_ptr<const LexerAutomaton>;
 
@@ -0,0 +1,92 @@
+#ifndef REGGEN_LEXER_POSITION_AUTOMATON_H
+#define REGGEN_LEXER_POSITION_AUTOMATON_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include "RegGen/Container/Array.h"
+#include "RegGen/Container/ArrayRef.h"
+#include "RegGen/Container/Bitset.h"
+#include "RegGen/Container/SmallVector.h"
+#include "RegGen/Lexer/Regex.h"
+#include "RegGen/Parser/TypeInfo.h"
+
+namespace RG {
+
+// partition of bytes into classes that no regex in the grammar tells apart
+class CharClassMap {
+ public:
+  static constexpr int kAlphabetSize = 256;
+
+  CharClassMap() { table_.fill(0); }
+
+  auto ClassCount() const -> int { return class_count_; }
+
+  auto Lookup(int ch) const -> int {
+    return table_[static_cast<uint8_t>(ch)];
+  }
+
+  // byte to class id
+  auto Table() const -> const auto& { return table_; }
+
+  static auto Compute(ArrayRef<CharRange> ranges) -> CharClassMap;
+
+  static auto FromTable(const Array<uint8_t, kAlphabetSize>& table)
+      -> CharClassMap {
+    CharClassMap result;
+    result.table_ = table;
+    result.class_count_ = *std::max_element(table.begin(), table.end()) + 1;
+
+    return result;
+  }
+
+ private:
+  int class_count_ = 1;
+  Array<uint8_t, kAlphabetSize> table_;
+};
+
+// Glushkov position automaton of all token definitions of a grammar
+//
+// positions, i.e. EntityExpr and RootExpr nodes, are numbered densely so that
+// sets of positions are stored as bitsets. a set of positions is a state of the
+// automaton, and a RootExpr position in it means its token is accepted
+struct PositionAutomaton {
+  CharClassMap char_classes = {};
+
+  // label of each position
+  SmallVector<const LabelExpr*> positions = {};
+
+  // set of positions where matching starts
+  Bitset initial = {};
+
+  // follow_pos of each position
+  SmallVector<Bitset> follow = {};
+
+  // positions that may consume a char class, indexed by class
+  SmallVector<Bitset> class_mask = {};
+
+  // positions of RootExpr where a token is accepted
+  Bitset accept_mask = {};
+  SmallVector<const TokenInfo*> acc_token = {};
+
+ public:
+  auto PositionCount() const -> int { return positions.size(); }
+
+  // set of positions reached from src by consuming a char of class cls
+  auto ComputeTarget(const Bitset& src, int cls) const -> Bitset;
+
+  // token accepted by a set of positions, token with lowest id is preferred
+  auto ComputeAcceptCategory(const Bitset& set) const -> const TokenInfo*;
+};
+
+// first byte of each char class, which stands for the whole class
+auto ComputeClassRepresentatives(const CharClassMap& classes)
+    -> SmallVector<int>;
+
+auto BuildPositionAutomaton(const MetaInfo& info)
+    -> std::unique_ptr<const PositionAutomaton>;
+
+}  // namespace RG
+
+#endif  // REGGEN_LEXER_POSITION_AUTOMATON_H
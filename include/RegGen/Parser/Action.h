@@ -1,6 +1,10 @@
 #ifndef REGGEN_PARSER_ACTION_H
 #define REGGEN_PARSER_ACTION_H
 
+#include <cassert>
+#include <cstdint>
+#include <variant>
+
 #include "RegGen/Parser/TypeInfo.h"
 
 namespace RG {
@@ -15,6 +19,31 @@ struct ActionReduce {
 
 using ParserAction = std::variant<ActionError, ActionShift, ActionReduce>;
 
+// action packed into 32 bits, 0 is error, n > 0 shifts to state n - 1 and
+// n < 0 reduces by production -n - 1
+using PackedAction = int32_t;
+
+constexpr PackedAction kPackedActionError = 0;
+
+inline auto PackShiftAction(int target_state) -> PackedAction {
+  return target_state + 1;
+}
+inline auto PackReduceAction(int production_index) -> PackedAction {
+  return -production_index - 1;
+}
+
+inline auto IsShiftAction(PackedAction action) -> bool { return action > 0; }
+inline auto IsReduceAction(PackedAction action) -> bool { return action < 0; }
+
+inline auto ShiftTarget(PackedAction action) -> int {
+  assert(IsShiftAction(action));
+  return action - 1;
+}
+inline auto ReduceProduction(PackedAction action) -> int {
+  assert(IsReduceAction(action));
+  return -(action + 1);
+}
+
 enum class ActionExecutionResult { Hungry, Consumed, Error };
 
 }  // namespace RG
@@ -5,7 +5,7 @@
 #include <memory>
 #include <utility>
 
-#include "RegGen/Container/FlatSet.h"
+#include "RegGen/Container/Bitset.h"
 #include "RegGen/Container/SmallVector.h"
 #include "RegGen/Parser/TypeInfo.h"
 
@@ -18,7 +18,8 @@ class Terminal;
 class Nonterminal;
 class Production;
 
-using TerminalSet = FlatSet<Terminal*>;
+// indexed by Terminal::Id()
+using TerminalSet = Bitset;
 using SymbolVec = SmallVector<Symbol*>;
 
 using SymbolKey = std::tuple<const SymbolInfo*, const ParserState*>;
@@ -43,21 +44,28 @@ class Symbol {
 
 class Terminal : public Symbol {
  public:
-  Terminal(const TokenInfo* info, const ParserState* version)
-      : info_(info), Symbol(info, version) {}
+  Terminal(const TokenInfo* info, const ParserState* version, int id)
+      : info_(info), id_(id), Symbol(info, version) {}
 
   auto Info() const -> const auto& { return info_; }
 
+  // dense index among terminals of the grammar, in creation order
+  auto Id() const -> int { return id_; }
+
  private:
   const TokenInfo* info_;
+  int id_;
 };
 
 class Nonterminal : public Symbol {
  public:
-  Nonterminal(const VariableInfo* info, const ParserState* version)
-      : info_(info), Symbol(info, version) {}
+  Nonterminal(const VariableInfo* info, const ParserState* version, int id)
+      : info_(info), id_(id), Symbol(info, version) {}
 
   auto Info() const -> const auto& { return info_; }
+
+  // dense index among nonterminals of the grammar, in creation order
+  auto Id() const -> int { return id_; }
   auto Productions() const -> const auto& { return productions_; }
 
   auto MayProduceEpsilon() const -> const auto& { return may_produce_epsilon_; }
@@ -69,6 +77,7 @@ class Nonterminal : public Symbol {
   friend class GrammarBuilder;
 
   const VariableInfo* info_;
+  int id_;
   SmallVector<Production*> productions_{};
 
   bool may_produce_epsilon_{false};
@@ -106,6 +115,11 @@ class Grammar {
   auto LookupTerminal(SymbolKey key) -> Terminal*;
   auto LookupNonterminal(SymbolKey key) -> Nonterminal*;
 
+  auto LookupTerminal(int id) const -> Terminal* { return term_list_[id]; }
+  auto LookupNonterminal(int id) const -> Nonterminal* {
+    return nonterm_list_[id];
+  }
+
  private:
   friend class GrammarBuilder;
 
@@ -114,6 +128,10 @@ class Grammar {
   std::map<SymbolKey, Terminal> terms_;
   std::map<SymbolKey, Nonterminal> nonterms_;
 
+  // symbols by id
+  SmallVector<Terminal*> term_list_;
+  SmallVector<Nonterminal*> nonterm_list_;
+
   std::vector<std::unique_ptr<Production>> productions_;
 };
 
@@ -11,6 +11,9 @@
 
 namespace RG {
 
+class BinaryReader;
+class BinaryWriter;
+
 class TypeInfo;
 class EnumTypeInfo;
 class BaseTypeInfo;
@@ -72,6 +75,13 @@ class MetaInfo {
 auto ResolveParserInfo(const std::string& config,
                        const AST::ASTTypeProxyManager* env)
     -> std::unique_ptr<MetaInfo>;
+
+// symbols and productions only, enough to run a parser from loaded tables
+auto SerializeParserInfo(BinaryWriter& writer, const MetaInfo& info) -> void;
+auto DeserializeParserInfo(BinaryReader& reader,
+                           const AST::ASTTypeProxyManager* env)
+    -> std::unique_ptr<MetaInfo>;
+
 }  // namespace RG
 
 #endif  // REGGEN_PARSER_META_INFO_H
\ No newline at end of file
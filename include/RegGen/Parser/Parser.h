@@ -1,35 +1,235 @@
 #ifndef REGGEN_PARSER_PARSER_H
 #define REGGEN_PARSER_PARSER_H
 
+#include <exception>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 #include "RegGen/AST/ASTBasic.h"
+#include "RegGen/Common/InheritRestrict.h"
 #include "RegGen/Container/Arena.h"
+#include "RegGen/Container/ArrayRef.h"
+#include "RegGen/Lexer/BitParallelNfa.h"
+#include "RegGen/Lexer/LazyDfa.h"
+#include "RegGen/Lexer/LexerAutomaton.h"
 #include "RegGen/Parser/Action.h"
 #include "RegGen/Parser/MetaInfo.h"
+#include "RegGen/Parser/ParsingTable.h"
+#include "RegGen/Parser/TokenBuffer.h"
 
 namespace RG {
 
 auto BootstrapParser(const std::string& config) -> std::string;
 
+class CompiledGrammar;
+class ParserAutomaton;
 class ParserContext;
+class ThreadPool;
 
-class GenericParser {
+enum class LexerMode {
+  // build the whole lexing table at initialization
+  Eager,
+
+  // compute lexer states on demand while tokenizing
+  Lazy,
+
+  // simulate the position automaton with bitsets, no determinization
+  Nfa,
+
+  // call a scanner generated by BootstrapParser, see ParserOptions::scanner
+  Direct,
+};
+
+// returns the longest token at offset, or an invalid token if none matches
+using ScannerFunction = AST::BasicASTToken (*)(std::string_view data,
+                                               int offset);
+
+struct ParserOptions {
+  LexerMode lexer_mode = LexerMode::Eager;
+
+  // max number of lexer states cached in lazy mode, at least 2
+  int lazy_cache_capacity = 1024;
+
+  // eager mode falls back to Nfa if the dfa would need more states than this,
+  // 0 means no limit
+  int dfa_state_limit = 8192;
+
+  // if set, tokenize with it and do not build any lexer automaton
+  ScannerFunction scanner = nullptr;
+
+  // skip reductions of pass-through unit productions like A = B! by going
+  // straight to the target state of A
+  bool eliminate_unit_productions = false;
+
+  // if set, lexer and parser automata are built on it, tables are identical
+  // to those built on the calling thread whatever its thread count
+  ThreadPool* thread_pool = nullptr;
+
+  // build the lexer on another thread while the parser is built, on
+  // thread_pool if set or else on a thread of its own
+  bool concurrent_construction = true;
+
+  // inputs of at least this many bytes are tokenized on a thread of their own
+  // while the calling thread parses, 0 disables it. a side that gets ahead
+  // yields briefly and then sleeps until the other catches up
+  int pipeline_threshold = 0;
+};
+
+// which tokens CompiledGrammar::Tokenize keeps
+enum class TokenFilter {
+  // every token, ignored ones included
+  All,
+
+  // only the tokens the parser reads
+  Significant,
+};
+
+// wall time of each step of constructing a CompiledGrammar, in milliseconds
+//
+// the lexer steps and the parser steps may overlap, the critical path is
+// resolve_ms + max(lexer_automaton_ms + lexing_table_ms,
+//                  parser_automaton_ms + parsing_table_ms)
+struct ConstructionTimings {
+  double resolve_ms = 0;
+
+  // position automaton and dfa, or the lazy or nfa lexer
+  double lexer_automaton_ms = 0;
+  double lexing_table_ms = 0;
+
+  double parser_automaton_ms = 0;
+  double parsing_table_ms = 0;
+
+  double total_ms = 0;
+};
+
+// outcome of one input of a batch, value is only meaningful without error
+struct ParseOutcome {
+  AST::ASTItem value;
+  std::exception_ptr error;
+
+  auto Succeeded() const -> bool { return error == nullptr; }
+};
+
+// outcomes of CompiledGrammar::ParseBatch in input order, the values live in
+// arenas owned by the result
+class BatchParseResult {
  public:
-  GenericParser(const std::string& config, const AST::ASTTypeProxyManager* env);
+  auto Size() const -> int { return outcomes_.size(); }
+  auto FailureCount() const -> int;
+
+  // ASTItem is only read through non-const members
+  auto operator[](int index) -> ParseOutcome& { return outcomes_[index]; }
+  auto operator[](int index) const -> const ParseOutcome& {
+    return outcomes_[index];
+  }
+
+  auto begin() { return outcomes_.begin(); }
+  auto end() { return outcomes_.end(); }
+  auto begin() const { return outcomes_.cbegin(); }
+  auto end() const { return outcomes_.cend(); }
+
+ private:
+  friend class CompiledGrammar;
+
+  // one per worker, each reused for all inputs the worker takes
+  std::vector<std::unique_ptr<Arena>> arenas_;
+  std::vector<ParseOutcome> outcomes_;
+};
+
+// mutable lexer state of one parsing thread, such as the cache of a lazy
+// dfa, kept out of CompiledGrammar so that parsing never writes to it
+class LexerContext {
+ private:
+  friend class CompiledGrammar;
+
+  // the grammar the state below was made for
+  const CompiledGrammar* owner_ = nullptr;
+
+  std::unique_ptr<LazyDfa> lazy_dfa_;
+  Bitset nfa_state_;
+  Bitset nfa_next_state_;
+};
+
+// lexing and parsing tables of a grammar together with the MetaInfo and ast
+// handles they refer to, immutable once constructed
+//
+// Parse is const and keeps its state on the stack or in a LexerContext, so one
+// instance may be shared by any number of threads parsing at the same time
+class CompiledGrammar : NonCopyable, NonMovable {
+ public:
+  CompiledGrammar(const std::string& config,
+                  const AST::ASTTypeProxyManager* env,
+                  const ParserOptions& options = {});
 
   auto GrammarInfo() const -> const auto& { return *info_; }
 
-  auto Initialize(const std::string& config,
-                  const AST::ASTTypeProxyManager* env) -> void;
+  // lexer engine in use, which may differ from the requested one
+  auto ActiveLexerMode() const -> LexerMode { return lexer_mode_; }
+
+  // all zero for a parser loaded from tables
+  auto Timings() const -> const ConstructionTimings& { return timings_; }
+
+  // lazy mode determinizes on the fly, a fresh lexer context discards what
+  // an earlier call computed
+  auto Parse(Arena& arena, std::string_view data) const -> AST::ASTItem;
+  auto Parse(LexerContext& lexer, Arena& arena, std::string_view data) const
+      -> AST::ASTItem;
+
+  // parses tokens this grammar produced by Tokenize, ignored ones are skipped
+  auto Parse(Arena& arena, const TokenBuffer& tokens) const -> AST::ASTItem;
+
+  // the tokens of data in order, exactly as parsing would read them. throws
+  // if some part of data matches no token
+  //
+  // the nul byte std::string keeps after data ends matching, so the eager
+  // lexer does not check for the end at every char unless some token may
+  // contain a nul byte
+  //
+  // with a pool, large inputs are cut into chunks that are lexed in parallel
+  // as if a token started at each chunk, then stitched where the tokens of a
+  // chunk line up with those running into it from the previous chunk
+  auto Tokenize(const std::string& data, TokenFilter filter = TokenFilter::All,
+                ThreadPool* pool = nullptr) const -> TokenBuffer;
+
+  // parses every input, on pool if set. inputs are handed out one at a time
+  // to whichever worker is free, each worker with its own arena and lexer
+  // context, and a failed input does not stop the others
+  auto ParseBatch(ArrayRef<std::string_view> inputs,
+                  ThreadPool* pool = nullptr) const -> BatchParseResult;
+  auto ParseBatch(ArrayRef<std::string> inputs,
+                  ThreadPool* pool = nullptr) const -> BatchParseResult;
+
+  // compiled tables and the symbols and productions they refer to, in a
+  // versioned and checksummed binary format
+  auto SerializeTables() const -> std::string;
+  auto WriteTables(const std::string& path) const -> void;
 
-  auto Parse(Arena& arena, const std::string& data) -> AST::ASTItem;
+  // loads serialized tables without running any construction, ast proxies
+  // are looked up in env by name
+  static auto LoadTables(std::string_view data,
+                         const AST::ASTTypeProxyManager* env,
+                         const ParserOptions& options = {})
+      -> std::unique_ptr<CompiledGrammar>;
+  static auto LoadTableFile(const std::string& path,
+                            const AST::ASTTypeProxyManager* env,
+                            const ParserOptions& options = {})
+      -> std::unique_ptr<CompiledGrammar>;
 
  private:
+  CompiledGrammar() = default;
+
+  auto Initialize(const std::string& config,
+                  const AST::ASTTypeProxyManager* env,
+                  const ParserOptions& options) -> void;
+
+  auto InitializeFromTables(std::string_view payload,
+                            const AST::ASTTypeProxyManager* env,
+                            const ParserOptions& options) -> void;
+
   auto LexerInitialState() const -> int { return 0; }
   auto ParserInitialState() const -> int { return 0; }
 
-  auto VerifyCharacter(int ch) const -> bool { return ch >= 0 && ch < 128; }
   auto VerifyLexingState(int state) const -> bool {
     return state >= 0 && state < dfa_state_num_;
   }
@@ -37,60 +237,169 @@ class GenericParser {
     return state >= 0 && state < pda_state_num_;
   }
 
-  auto LookupLexingTransition(int state, int ch) const -> int {
-    assert(VerifyLexingState(state) && VerifyCharacter(ch));
-    return lexing_table_[128 * state + ch];
+  auto LookupLexingTransition(int state, char ch) const -> int {
+    assert(VerifyLexingState(state));
+    return lexing_table_[char_class_num_ * state + char_classes_.Lookup(ch)];
   }
   auto LookupAcceptedToken(int state) const -> const TokenInfo* {
     assert(VerifyLexingState(state));
     return acc_token_lookup_[state];
   }
-  auto LookupParserAction(int state, int term_id) const -> ParserAction {
+  auto LookupParserAction(int state, int term_id) const -> PackedAction {
     assert(VerifyParsingState(state) && term_id >= 0 && term_id < term_num_);
-    return action_table_[term_num_ * state + term_id];
+    return action_table_.Lookup(state, term_id);
   }
-  auto LookupParserActionOnEof(int state) const -> ParserAction {
+  auto LookupParserActionOnEof(int state) const -> PackedAction {
     assert(VerifyParsingState(state));
     return eof_action_table_[state];
   }
   auto LookupParsingGoto(int state, int nonterm_id) const -> int {
     assert(VerifyParsingState(state) && nonterm_id >= 0 &&
-           nonterm_id <= nonterm_num_);
-    return goto_table_[nonterm_num_ * state + nonterm_id];
+           nonterm_id < nonterm_num_);
+    return goto_table_.Lookup(nonterm_id, state);
   }
 
-  auto LoadToken(std::string_view data, int offset) -> AST::BasicASTToken;
+  auto InitializeLexer(const ParserOptions& options) -> void;
+  auto InitializeLexingTable(const LexerAutomaton& dfa) -> void;
+  auto InitializeParsingTable(const ParserAutomaton& pda) -> void;
+  auto InitializeLazyLexer(int cache_capacity) -> void;
+  auto InitializeNfaLexer() -> void;
+  auto InitializeProductionTable() -> void;
+  auto InitializeDefaultReductions() -> void;
+
+  template <typename T>
+  auto ParseBatchImpl(ArrayRef<T> inputs, ThreadPool* pool) const
+      -> BatchParseResult;
 
-  auto ForwardParserAction(ParserContext& ctx, ActionShift action,
-                           const AST::BasicASTToken& tok)
-      -> ActionExecutionResult;
-  auto ForwardParserAction(ParserContext& ctx, ActionReduce action,
-                           const AST::BasicASTToken& tok)
-      -> ActionExecutionResult;
-  auto ForwardParserAction(ParserContext& ctx, ActionError action,
-                           const AST::BasicASTToken& tok)
-      -> ActionExecutionResult;
+  auto ParsePipelined(LexerContext& lexer, Arena& arena,
+                      std::string_view data) const -> AST::ASTItem;
 
-  void FeedParserContext(ParserContext& ctx, const AST::BasicASTToken& tok);
+  auto PrepareLexerContext(LexerContext& lexer) const -> void;
+  auto LoadToken(LexerContext& lexer, std::string_view data, int offset) const
+      -> AST::BasicASTToken;
+  auto LoadTerminatedToken(LexerContext& lexer, const std::string& data,
+                           int offset) const -> AST::BasicASTToken;
+  auto InitializeSentinel() -> void;
+
+  auto ApplyReduction(ParserContext& ctx, int production) const -> void;
+  auto ApplyDefaultReductions(ParserContext& ctx) const -> void;
+
+  void FeedParserContext(ParserContext& ctx,
+                         const AST::BasicASTToken& tok) const;
 
  private:
   std::unique_ptr<MetaInfo> info_;
 
+  ConstructionTimings timings_;
+
   // parser
   int token_num_;
   int term_num_;
   int nonterm_num_;
 
+  int char_class_num_;
   int dfa_state_num_;
   int pda_state_num_;
 
+  CharClassMap char_classes_;  // 256 entries, byte to char class
   HeapArray<const TokenInfo*> acc_token_lookup_;  // 1 column, token_num_ rows
-  HeapArray<int> lexing_table_;  // 128 columns, dfa_state_num_ rows
+  HeapArray<int> lexing_table_;  // char_class_num_ columns, dfa_state_num_ rows
+
+  // no lexing state moves on a nul byte, so one after the input ends a match
+  bool nul_ends_match_;
 
-  HeapArray<ParserAction>
+  // lazy, nfa and direct mode only, replace the lexing table
+  LexerMode lexer_mode_;
+  ScannerFunction scanner_;
+  int lazy_cache_capacity_;
+  int pipeline_threshold_;
+  std::unique_ptr<const PositionAutomaton> position_automaton_;
+  std::unique_ptr<const BitParallelNfa> nfa_;
+
+  RowDisplacementTable
       action_table_;  // term_num_ columns, pda_state_num_ rows
-  HeapArray<ParserAction> eof_action_table_;  // 1 column, pda_state_num_ rows
-  HeapArray<int> goto_table_;  // nonterm_num_ columns, pda_state_num_ rows
+  HeapArray<PackedAction>
+      eof_action_table_;  // 1 column, pda_state_num_ rows
+  RowDisplacementTable
+      goto_table_;  // pda_state_num_ columns, nonterm_num_ rows
+
+  // the only reduction of states that never need a lookahead, or error
+  HeapArray<PackedAction>
+      default_reduction_table_;  // 1 column, pda_state_num_ rows
+
+  // what a reduction needs of each production, so the parsing loop does not
+  // chase ProductionInfo pointers
+  int root_variable_id_;
+  HeapArray<int> production_rhs_length_;  // 1 column, production rows
+  HeapArray<int> production_lhs_id_;      // 1 column, production rows
+  HeapArray<const AST::ASTHandle*>
+      production_handle_;  // 1 column, production rows
+};
+
+// a parser over a compiled grammar, which it may share with other parsers
+//
+// each parser keeps its own lexer context, so a parser must not be used by
+// more than one thread at a time, while parsers sharing a grammar may
+class GenericParser {
+ public:
+  GenericParser(const std::string& config, const AST::ASTTypeProxyManager* env,
+                const ParserOptions& options = {});
+  explicit GenericParser(std::shared_ptr<const CompiledGrammar> grammar);
+
+  auto Compiled() const -> const auto& { return grammar_; }
+
+  auto GrammarInfo() const -> const auto& { return grammar_->GrammarInfo(); }
+  auto ActiveLexerMode() const -> LexerMode {
+    return grammar_->ActiveLexerMode();
+  }
+  auto Timings() const -> const ConstructionTimings& {
+    return grammar_->Timings();
+  }
+
+  auto Initialize(const std::string& config,
+                  const AST::ASTTypeProxyManager* env,
+                  const ParserOptions& options = {}) -> void;
+
+  auto Parse(Arena& arena, const std::string& data) -> AST::ASTItem {
+    return grammar_->Parse(lexer_, arena, data);
+  }
+  auto Parse(Arena& arena, const TokenBuffer& tokens) const -> AST::ASTItem {
+    return grammar_->Parse(arena, tokens);
+  }
+
+  auto Tokenize(const std::string& data, TokenFilter filter = TokenFilter::All,
+                ThreadPool* pool = nullptr) const -> TokenBuffer {
+    return grammar_->Tokenize(data, filter, pool);
+  }
+
+  auto ParseBatch(ArrayRef<std::string_view> inputs,
+                  ThreadPool* pool = nullptr) const -> BatchParseResult {
+    return grammar_->ParseBatch(inputs, pool);
+  }
+  auto ParseBatch(ArrayRef<std::string> inputs,
+                  ThreadPool* pool = nullptr) const -> BatchParseResult {
+    return grammar_->ParseBatch(inputs, pool);
+  }
+
+  auto SerializeTables() const -> std::string {
+    return grammar_->SerializeTables();
+  }
+  auto WriteTables(const std::string& path) const -> void {
+    grammar_->WriteTables(path);
+  }
+
+  static auto LoadTables(std::string_view data,
+                         const AST::ASTTypeProxyManager* env,
+                         const ParserOptions& options = {})
+      -> std::unique_ptr<GenericParser>;
+  static auto LoadTableFile(const std::string& path,
+                            const AST::ASTTypeProxyManager* env,
+                            const ParserOptions& options = {})
+      -> std::unique_ptr<GenericParser>;
+
+ private:
+  std::shared_ptr<const CompiledGrammar> grammar_;
+  LexerContext lexer_;
 };
 
 template <typename T>
@@ -104,15 +413,63 @@ class BasicParser {
 
     return result.Extract<ResultType>();
   }
+  auto Parse(Arena& arena, const TokenBuffer& tokens) -> ResultType {
+    auto result = parser_->Parse(arena, tokens);
+
+    return result.Extract<ResultType>();
+  }
+
+  auto Tokenize(const std::string& data, TokenFilter filter = TokenFilter::All,
+                ThreadPool* pool = nullptr) const -> TokenBuffer {
+    return parser_->Tokenize(data, filter, pool);
+  }
+
+  // values of the outcomes extract to ResultType
+  auto ParseBatch(ArrayRef<std::string_view> inputs,
+                  ThreadPool* pool = nullptr) const -> BatchParseResult {
+    return parser_->ParseBatch(inputs, pool);
+  }
+  auto ParseBatch(ArrayRef<std::string> inputs,
+                  ThreadPool* pool = nullptr) const -> BatchParseResult {
+    return parser_->ParseBatch(inputs, pool);
+  }
+
+  auto Timings() const -> const ConstructionTimings& {
+    return parser_->Timings();
+  }
+
+  // the grammar, to create more parsers on it for other threads
+  auto Compiled() const -> const auto& { return parser_->Compiled(); }
+
+  static auto Create(std::shared_ptr<const CompiledGrammar> grammar) -> Ptr {
+    auto result = std::make_unique<BasicParser<T>>();
+    result->parser_ = std::make_unique<GenericParser>(std::move(grammar));
+
+    return result;
+  }
 
   static auto Create(const std::string& config,
-                     const AST::ASTTypeProxyManager* env) -> Ptr {
+                     const AST::ASTTypeProxyManager* env,
+                     const ParserOptions& options = {}) -> Ptr {
     auto result = std::make_unique<BasicParser<T>>();
-    result->parser_ = std::make_unique<GenericParser>(config, env);
+    result->parser_ = std::make_unique<GenericParser>(config, env, options);
 
     return result;
   }
 
+  static auto Load(const std::string& path,
+                   const AST::ASTTypeProxyManager* env,
+                   const ParserOptions& options = {}) -> Ptr {
+    auto result = std::make_unique<BasicParser<T>>();
+    result->parser_ = GenericParser::LoadTableFile(path, env, options);
+
+    return result;
+  }
+
+  auto WriteTables(const std::string& path) const -> void {
+    parser_->WriteTables(path);
+  }
+
  private:
   std::unique_ptr<GenericParser> parser_;
 };
@@ -2,8 +2,9 @@
 #define REGGEN_PARSER_PARSER_AUTOMATON_H
 
 #include <cassert>
+#include <cstdint>
+#include <deque>
 #include <functional>
-#include <map>
 #include <optional>
 #include <variant>
 
@@ -15,6 +16,7 @@
 namespace RG {
 
 class ParserState;
+class ThreadPool;
 
 class ParserItem {
  public:
@@ -58,6 +60,16 @@ class ParserItem {
     return cursor_ == production_->Right().size();
   }
 
+  friend auto operator==(const ParserItem& lhs, const ParserItem& rhs)
+      -> bool {
+    return lhs.production_ == rhs.production_ && lhs.cursor_ == rhs.cursor_;
+  }
+
+  auto Hash() const -> size_t {
+    auto h = reinterpret_cast<uintptr_t>(production_);
+    return (h ^ (h >> 16)) * 31 + cursor_;
+  }
+
  private:
   const ProductionInfo* production_;
   int cursor_;
@@ -72,7 +84,10 @@ struct PdaEdgeReduce {
   const ProductionInfo* production;
 };
 
-using PdaEdge = std::variant<PdaEdgeShift, PdaEdgeReduce>;
+// a conflict resolved to neither shift nor reduce, by %nonassoc
+struct PdaEdgeError {};
+
+using PdaEdge = std::variant<PdaEdgeShift, PdaEdgeReduce, PdaEdgeError>;
 
 class ParserState {
  public:
@@ -87,6 +102,10 @@ class ParserState {
 
   auto RegisterReduce(const ProductionInfo* p, const TokenInfo* tok) -> void;
   auto RegisterReduceOnEof(const ProductionInfo* p) -> void;
+  auto RegisterError(const TokenInfo* tok) -> void;
+
+  // replaces the target of an existing shift or goto edge
+  auto RedirectShift(const ParserState* dest, const SymbolInfo* s) -> void;
 
  private:
   int id_;
@@ -96,24 +115,69 @@ class ParserState {
   std::unordered_map<const VariableInfo*, const ParserState*> goto_map_;
 };
 
+// states are identified by their kernel items, the closure is never stored
+//
+// kernels are interned in an open addressing table of state ids, keyed by a
+// hash computed once per kernel, so a lookup compares full item sets only on
+// a hash match
 class ParserAutomaton {
  public:
   auto StateCount() const -> int { return states_.size(); }
-  auto LookupState(int id) const -> const ParserState* { return ptrs_.at(id); }
+  auto LookupState(int id) const -> const ParserState* {
+    return &states_.at(id).state;
+  }
+  auto LookupState(int id) -> ParserState* { return &states_.at(id).state; }
+  auto LookupKernel(int id) const -> const ItemSet& {
+    return states_.at(id).kernel;
+  }
 
-  auto States() const { return states_; }
+  // returns the state of the kernel, and whether it was newly created
+  auto MakeState(ItemSet kernel) -> std::pair<ParserState*, bool>;
 
-  auto MakeState(const ItemSet& items) -> ParserState*;
+  // states are visited in the order of their ids
   auto EnumerateState(
       std::function<void(const ItemSet&, ParserState&)> callback) -> void;
 
  private:
-  SmallVector<ParserState*> ptrs_;
-  std::map<ItemSet, ParserState> states_;
+  struct StateEntry {
+    ItemSet kernel;
+    size_t hash;
+    ParserState state;
+  };
+
+  static auto HashKernel(const ItemSet& kernel) -> size_t;
+
+  auto GrowSlots() -> void;
+
+  // deque keeps ParserState addresses stable
+  std::deque<StateEntry> states_;
+
+  // ids of states_ or -1, size is a power of 2
+  SmallVector<int> slots_;
+};
+
+enum class LookaheadAlgorithm {
+  // DeRemer and Pennello's relations, solved by digraph traversals
+  Relations,
+  // FIRST and FOLLOW of a grammar with a symbol per (symbol, state) pair,
+  // much slower, kept as a reference
+  ExtendedGrammar,
+};
+
+struct LALROptions {
+  LookaheadAlgorithm lookahead = LookaheadAlgorithm::Relations;
+
+  // shifts and gotos into a state that can only reduce a pass-through unit
+  // production A -> B are redirected to the target of A, which skips the
+  // reduction at runtime
+  bool eliminate_unit_productions = false;
+
+  // if set, lr(0) states are expanded on it, the automaton is the same
+  ThreadPool* thread_pool = nullptr;
 };
 
-auto BuildLALRAutomaton(
-    const MetaInfo& info) -> std::unique_ptr<const ParserAutomaton>;
+auto BuildLALRAutomaton(const MetaInfo& info, const LALROptions& options = {})
+    -> std::unique_ptr<const ParserAutomaton>;
 
 }  // namespace RG
 
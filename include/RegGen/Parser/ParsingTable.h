@@ -0,0 +1,74 @@
+#ifndef REGGEN_PARSER_PARSING_TABLE_H
+#define REGGEN_PARSER_PARSING_TABLE_H
+
+#include <cassert>
+#include <cstdint>
+
+#include "RegGen/Container/ArrayRef.h"
+#include "RegGen/Container/HeapArray.h"
+
+namespace RG {
+
+class BinaryReader;
+class BinaryWriter;
+
+// sparse 2d table compressed by row displacement (comb vector), as in yacc
+//
+// every row has a default value, the other entries of all rows are overlaid
+// in one vector at a per-row base offset. check_ records which row owns a
+// slot, so a lookup is O(1):
+//
+//   value_[base_[row] + col] if check_[base_[row] + col] == row
+//   default_[row] otherwise
+class RowDisplacementTable {
+ public:
+  auto RowCount() const -> int { return default_.size(); }
+  auto ColumnCount() const -> int { return col_num_; }
+
+  // number of slots in the overlaid vector
+  auto SlotCount() const -> int { return value_.size(); }
+
+  auto Lookup(int row, int col) const -> int32_t {
+    assert(row >= 0 && row < RowCount() && col >= 0 && col < col_num_);
+
+    auto index = base_[row] + col;
+    return check_[index] == row ? value_[index] : default_[row];
+  }
+
+  // invoke callback with every value stored, defaults included
+  template <typename F>
+  auto ForEachValue(F callback) const -> void {
+    for (auto value : default_) {
+      callback(value);
+    }
+    for (int i = 0; i < value_.size(); ++i) {
+      if (check_[i] != -1) {
+        callback(value_[i]);
+      }
+    }
+  }
+
+  // dense is row-major of row_num rows, entries equal to the default of their
+  // row are dropped
+  static auto Compress(ArrayRef<int32_t> dense, int col_num,
+                       ArrayRef<int32_t> defaults) -> RowDisplacementTable;
+
+  auto Serialize(BinaryWriter& writer) const -> void;
+
+  // throws ParserConstructionError if the layout is inconsistent
+  static auto Deserialize(BinaryReader& reader, int row_num, int col_num)
+      -> RowDisplacementTable;
+
+ private:
+  int col_num_ = 0;
+
+  HeapArray<int32_t> default_;  // 1 column, row_num rows
+  HeapArray<int32_t> base_;     // 1 column, row_num rows
+
+  HeapArray<int32_t> check_;  // owner row of each slot, or -1
+  HeapArray<int32_t> value_;
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_PARSER_PARSING_TABLE_H
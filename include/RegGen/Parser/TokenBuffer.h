@@ -0,0 +1,72 @@
+#ifndef REGGEN_PARSER_TOKEN_BUFFER_H
+#define REGGEN_PARSER_TOKEN_BUFFER_H
+
+#include <cassert>
+#include <vector>
+
+#include "RegGen/AST/ASTBasic.h"
+#include "RegGen/Container/ArrayRef.h"
+
+namespace RG {
+
+// tokens of an input in order, stored as parallel arrays of offsets, lengths
+// and tags, so that a pass over one field does not load the others
+//
+// filled by CompiledGrammar::Tokenize and read back by CompiledGrammar::Parse,
+// the tags are only meaningful to the grammar that produced them
+class TokenBuffer {
+ public:
+  auto Size() const -> int { return tags_.size(); }
+  auto Empty() const -> bool { return tags_.empty(); }
+
+  auto Offsets() const -> ArrayRef<int> { return offsets_; }
+  auto Lengths() const -> ArrayRef<int> { return lengths_; }
+  auto Tags() const -> ArrayRef<int> { return tags_; }
+
+  auto operator[](int index) const -> AST::BasicASTToken {
+    assert(index >= 0 && index < Size());
+    return AST::BasicASTToken{offsets_[index], lengths_[index], tags_[index]};
+  }
+
+  auto Append(const AST::BasicASTToken& tok) -> void {
+    offsets_.push_back(tok.Offset());
+    lengths_.push_back(tok.Length());
+    tags_.push_back(tok.Tag());
+  }
+
+  // overwrites a token in place, for filling a resized buffer out of order
+  auto Assign(int index, const AST::BasicASTToken& tok) -> void {
+    assert(index >= 0 && index < Size());
+    offsets_[index] = tok.Offset();
+    lengths_[index] = tok.Length();
+    tags_[index] = tok.Tag();
+  }
+
+  auto Reserve(int size) -> void {
+    offsets_.reserve(size);
+    lengths_.reserve(size);
+    tags_.reserve(size);
+  }
+
+  // new tokens are invalid until assigned
+  auto Resize(int size) -> void {
+    offsets_.resize(size, -1);
+    lengths_.resize(size, -1);
+    tags_.resize(size, -1);
+  }
+
+  auto Clear() -> void {
+    offsets_.clear();
+    lengths_.clear();
+    tags_.clear();
+  }
+
+ private:
+  std::vector<int> offsets_;
+  std::vector<int> lengths_;
+  std::vector<int> tags_;
+};
+
+}  // namespace RG
+
+#endif  // REGGEN_PARSER_TOKEN_BUFFER_H
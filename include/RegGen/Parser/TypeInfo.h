@@ -134,6 +134,8 @@ class SymbolInfo {
   std::string name_;
 };
 
+enum class Associativity { Left, Right, NonAssoc };
+
 class TokenInfo : public SymbolInfo {
  public:
   TokenInfo(int id = -1, const std::string& name = "") : SymbolInfo(id, name) {}
@@ -143,11 +145,18 @@ class TokenInfo : public SymbolInfo {
   auto TextDefinition() const -> const auto& { return text_def_; }
   auto TreeDefinition() const -> const auto& { return ast_def_; }
 
+  // 0 if not declared, a higher level binds tighter
+  auto Precedence() const -> const auto& { return precedence_; }
+  auto Assoc() const -> const auto& { return assoc_; }
+
  private:
   friend class MetaInfo::Builder;
 
   std::string text_def_;
   std::unique_ptr<RootExpr> ast_def_;
+
+  int precedence_ = 0;
+  Associativity assoc_ = Associativity::NonAssoc;
 };
 
 class VariableInfo : public SymbolInfo {
@@ -174,11 +183,15 @@ class ProductionInfo {
 
   auto Handle() const -> const auto& { return handle_; }
 
+  // token given by %prec or else the last token of rhs, may be nullptr
+  auto PrecedenceToken() const -> const auto& { return precedence_; }
+
  private:
   friend class MetaInfo::Builder;
 
   VariableInfo* lhs_;
   SmallVector<SymbolInfo*> rhs_;
+  const TokenInfo* precedence_ = nullptr;
 
   std::unique_ptr<AST::ASTHandle> handle_;
 };
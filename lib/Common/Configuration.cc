@@ -101,6 +101,17 @@ auto ParseBaseDefinition(ParserConfiguration& config, const char*& s) -> void {
   config.bases.push_back(BaseDefinition{std::move(name)});
 }
 
+auto ParsePrecedenceDefinition(ParserConfiguration& config, const char*& s,
+                               std::string assoc) -> void {
+  SmallVector<std::string> tokens;
+  do {
+    tokens.push_back(ParseIdentifier(s));
+  } while (!TryParseConstant(s, ";"));
+
+  config.precedences.push_back(
+      PrecedenceDefinition{std::move(assoc), std::move(tokens)});
+}
+
 auto ParseNodeDefinition(ParserConfiguration& config, const char*& s) -> void {
   auto name = ParseIdentifier(s);
   std::string parent;
@@ -158,6 +169,11 @@ auto ParseRuleDefinition(ParserConfiguration& config, const char*& s) -> void {
       SkipWhitespace(s);
     }
 
+    std::string precedence;
+    if (TryParseConstant(s, "%prec")) {
+      precedence = ParseIdentifier(s);
+    }
+
     std::optional<QualType> klass_hint;
     if (TryParseConstant(s, "->")) {
       if (TryParseConstant(s, "_")) {
@@ -167,7 +183,8 @@ auto ParseRuleDefinition(ParserConfiguration& config, const char*& s) -> void {
       }
     }
 
-    items.push_back(RuleItem{std::move(rhs), std::move(klass_hint)});
+    items.push_back(RuleItem{std::move(rhs), std::move(klass_hint),
+                             std::move(precedence)});
 
     if (TryParseConstant(s, ";")) {
       break;
@@ -192,6 +209,12 @@ void ParseConfigInternal(ParserConfiguration& config, const char*& s) {
       ParseNodeDefinition(config, s);
     } else if (TryParseConstant(s, "rule")) {
       ParseRuleDefinition(config, s);
+    } else if (TryParseConstant(s, "%left")) {
+      ParsePrecedenceDefinition(config, s, "left");
+    } else if (TryParseConstant(s, "%right")) {
+      ParsePrecedenceDefinition(config, s, "right");
+    } else if (TryParseConstant(s, "%nonassoc")) {
+      ParsePrecedenceDefinition(config, s, "nonassoc");
     } else {
       throw ConfigParsingError{s, "unexpected token"};
     }
@@ -45,7 +45,7 @@ auto ToStringParserAction(const MetaInfo& /*info*/, PdaEdge action)
         "reduce ({})",
         ToStringProduction(*std::get<PdaEdgeReduce>(action).production));
   } else {
-    throw 0;
+    return "error";
   }
 }
 
@@ -96,18 +96,18 @@ auto PrintGrammar(const Grammar& g) -> void {
     PrintFormatted("{}_{}\n", var.Info()->Name(), ver);
 
     PrintFormatted("FIRST = {{ ");
-    for (const auto& s : var.FirstSet()) {
-      PrintFormatted("{} ", s->Info()->Name());
-    }
+    var.FirstSet().for_each([&](int id) {
+      PrintFormatted("{} ", g.LookupTerminal(id)->Info()->Name());
+    });
     if (var.MayProduceEpsilon()) {
       PrintFormatted("$epsilon ");
     }
     PrintFormatted("}}\n");
 
     PrintFormatted("FOLLOW = {{ ");
-    for (const auto& s : var.FollowSet()) {
-      PrintFormatted("{} ", s->Info()->Name());
-    }
+    var.FollowSet().for_each([&](int id) {
+      PrintFormatted("{} ", g.LookupTerminal(id)->Info()->Name());
+    });
     if (var.MayProduceEpsilon()) {
       PrintFormatted("$eof ");
     }
@@ -118,6 +118,8 @@ auto PrintGrammar(const Grammar& g) -> void {
 auto PrintLexerAutomaton(const MetaInfo& /*info*/, const LexerAutomaton& dfa)
     -> void {
   PrintFormatted("[Lexing Automaton]\n");
+  PrintFormatted("{} states ({} before minimization)\n\n", dfa.StateCount(),
+                 dfa.UnminimizedStateCount());
 
   for (int id = 0; id < dfa.StateCount(); ++id) {
     const auto* const state = dfa.LookupState(id);
@@ -126,8 +128,13 @@ auto PrintLexerAutomaton(const MetaInfo& /*info*/, const LexerAutomaton& dfa)
         state->acc_token ? state->acc_token->Name() : "NOT ACCEPTED");
 
     for (const auto& edge : state->transitions) {
-      PrintFormatted("  {} -> {}\n", EscapeCharacter(edge.first),
-                     edge.second->id);
+      if (edge.range.Length() == 1) {
+        PrintFormatted("  {} -> {}\n", EscapeCharacter(edge.range.Min()),
+                       edge.target->id);
+      } else {
+        PrintFormatted("  {}-{} -> {}\n", EscapeCharacter(edge.range.Min()),
+                       EscapeCharacter(edge.range.Max()), edge.target->id);
+      }
     }
 
     PrintFormatted("\n");
@@ -0,0 +1,42 @@
+#include "RegGen/Common/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "RegGen/Common/Error.h"
+
+namespace RG {
+
+MappedFile::MappedFile(const std::string& path) {
+  auto fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw ParserConstructionError{"MappedFile: cannot open file"};
+  }
+
+  struct stat st {};
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw ParserConstructionError{"MappedFile: cannot stat file"};
+  }
+
+  size_ = st.st_size;
+  if (size_ != 0) {
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+
+  if (data_ == MAP_FAILED) {
+    data_ = nullptr;
+    throw ParserConstructionError{"MappedFile: cannot map file"};
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+}  // namespace RG
@@ -0,0 +1,176 @@
+#include "RegGen/Common/ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace RG {
+
+namespace {
+
+// pool and deque index of the current thread, if it is a worker
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+}  // namespace
+
+ThreadPool::ThreadPool(int thread_num) {
+  if (thread_num <= 0) {
+    thread_num = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (int i = 0; i < thread_num; ++i) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  for (int i = 0; i < thread_num; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{sleep_mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+auto ThreadPool::Submit(std::function<void()> task) -> std::future<void> {
+  // std::function must be copyable
+  auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+  auto result = packaged->get_future();
+
+  Push([packaged] { (*packaged)(); });
+  return result;
+}
+
+auto ThreadPool::ParallelFor(int n, const std::function<void(int)>& body)
+    -> void {
+  if (n <= 1) {
+    if (n == 1) {
+      body(0);
+    }
+    return;
+  }
+
+  // helpers may start after the call returned, they only touch this then
+  struct Shared {
+    std::atomic<int> next = 0;
+    std::atomic<int> running = 0;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+  };
+
+  auto shared = std::make_shared<Shared>();
+  const auto* body_ptr = &body;
+
+  // an index is only taken after running is raised, so once next passed n,
+  // running reaching 0 means body is not being called any more
+  const auto run = [shared, body_ptr, n] {
+    shared->running += 1;
+
+    for (int i; (i = shared->next++) < n;) {
+      try {
+        (*body_ptr)(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{shared->mutex};
+        if (!shared->error) {
+          shared->error = std::current_exception();
+        }
+        shared->next = n;
+      }
+    }
+
+    if (--shared->running == 0) {
+      std::lock_guard<std::mutex> lock{shared->mutex};
+      shared->finished.notify_all();
+    }
+  };
+
+  const auto helper_num = std::min(n - 1, ThreadCount());
+  for (int i = 0; i < helper_num; ++i) {
+    Push(run);
+  }
+
+  run();
+
+  std::unique_lock<std::mutex> lock{shared->mutex};
+  BlockUntil(shared->finished, lock, [&] { return shared->running == 0; });
+
+  if (shared->error) {
+    std::rethrow_exception(shared->error);
+  }
+}
+
+auto ThreadPool::Push(std::function<void()> task) -> void {
+  const int index = current_pool == this
+                        ? current_worker
+                        : next_queue_++ % static_cast<unsigned>(queues_.size());
+
+  {
+    std::lock_guard<std::mutex> lock{queues_[index]->mutex};
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  pending_ += 1;
+
+  // a worker checks pending_ under sleep_mutex_ before it sleeps
+  {
+    std::lock_guard<std::mutex> lock{sleep_mutex_};
+  }
+  wake_.notify_one();
+}
+
+auto ThreadPool::TryPop(int worker, std::function<void()>& task) -> bool {
+  // newest task of its own
+  {
+    auto& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock{queue.mutex};
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      pending_ -= 1;
+      return true;
+    }
+  }
+
+  // oldest task of another worker
+  for (int i = 1; i < queues_.size(); ++i) {
+    auto& queue = *queues_[(worker + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock{queue.mutex};
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      pending_ -= 1;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+auto ThreadPool::WorkerLoop(int worker) -> void {
+  current_pool = this;
+  current_worker = worker;
+
+  std::function<void()> task;
+  while (true) {
+    if (TryPop(worker, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock{sleep_mutex_};
+    BlockUntil(wake_, lock, [&] { return stopping_ || pending_ > 0; });
+    if (stopping_ && pending_ == 0) {
+      return;
+    }
+  }
+}
+
+}  // namespace RG
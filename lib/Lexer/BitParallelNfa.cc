@@ -0,0 +1,51 @@
+#include "RegGen/Lexer/BitParallelNfa.h"
+
+namespace RG {
+
+static_assert(Bitset::kWordBits % BitParallelNfa::kChunkBits == 0);
+
+BitParallelNfa::BitParallelNfa(const PositionAutomaton* pa) : pa_(pa) {
+  const auto position_num = pa->PositionCount();
+  const auto chunk_num = (position_num + kChunkBits - 1) / kChunkBits;
+
+  follow_table_.reserve(chunk_num * kChunkSize);
+  for (int chunk = 0; chunk < chunk_num; ++chunk) {
+    const auto base = chunk * kChunkSize;
+
+    follow_table_.push_back(Bitset{position_num});
+    for (int bits = 1; bits < kChunkSize; ++bits) {
+      // extend the subset without its lowest bit by that bit
+      auto row = follow_table_[base + (bits & (bits - 1))];
+
+      auto pos = chunk * kChunkBits + __builtin_ctz(bits);
+      if (pos < position_num) {
+        row |= pa->follow[pos];
+      }
+
+      follow_table_.push_back(std::move(row));
+    }
+  }
+}
+
+auto BitParallelNfa::Transit(const Bitset& src, char ch, Bitset& dest) const
+    -> void {
+  assert(src.size() == PositionCount() && dest.size() == PositionCount());
+
+  const auto* mask = pa_->class_mask[pa_->char_classes.Lookup(ch)].data();
+  const auto* words = src.data();
+
+  dest.clear();
+  for (int i = 0; i < src.word_count(); ++i) {
+    constexpr auto kChunksPerWord = Bitset::kWordBits / kChunkBits;
+
+    auto word = words[i] & mask[i];
+    for (auto chunk = i * kChunksPerWord; word != 0;
+         word >>= kChunkBits, ++chunk) {
+      if (auto bits = word & (kChunkSize - 1); bits != 0) {
+        dest |= follow_table_[chunk * kChunkSize + bits];
+      }
+    }
+  }
+}
+
+}  // namespace RG
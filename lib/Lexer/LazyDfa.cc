@@ -0,0 +1,67 @@
+#include "RegGen/Lexer/LazyDfa.h"
+
+#include <utility>
+
+namespace RG {
+
+LazyDfa::LazyDfa(const PositionAutomaton* pa, int cache_capacity)
+    : pa_(pa),
+      class_num_(pa->char_classes.ClassCount()),
+      cache_capacity_(cache_capacity) {
+  // initial state and a target state should fit in the cache
+  assert(cache_capacity >= 2);
+
+  InternState(pa_->initial);
+}
+
+auto LazyDfa::Transit(int state, char ch) -> int {
+  assert(state >= 0 && state < CachedStateCount());
+
+  const auto cls = pa_->char_classes.Lookup(ch);
+  if (auto target = transitions_[state * class_num_ + cls];
+      target != kUnknownState) {
+    return target;
+  }
+
+  auto target_set = pa_->ComputeTarget(states_[state], cls);
+
+  auto target = kDeadState;
+  if (target_set.any()) {
+    if (auto it = state_lookup_.find(target_set); it != state_lookup_.end()) {
+      target = it->second;
+    } else if (CachedStateCount() < cache_capacity_) {
+      target = InternState(std::move(target_set));
+    } else {
+      // source state is dropped, so the edge is not recorded
+      Flush();
+      return InternState(std::move(target_set));
+    }
+  }
+
+  transitions_[state * class_num_ + cls] = target;
+  return target;
+}
+
+auto LazyDfa::InternState(Bitset set) -> int {
+  int id = CachedStateCount();
+
+  acc_token_.push_back(pa_->ComputeAcceptCategory(set));
+  transitions_.resize(transitions_.size() + class_num_, kUnknownState);
+  state_lookup_.emplace(set, id);
+  states_.push_back(std::move(set));
+
+  return id;
+}
+
+auto LazyDfa::Flush() -> void {
+  flush_count_ += 1;
+
+  states_.clear();
+  acc_token_.clear();
+  transitions_.clear();
+  state_lookup_.clear();
+
+  InternState(pa_->initial);
+}
+
+}  // namespace RG
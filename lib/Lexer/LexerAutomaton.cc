@@ -2,265 +2,346 @@
 
 #include <algorithm>
 #include <iterator>
-#include <map>
 #include <numeric>
 #include <unordered_map>
 
 #include "RegGen/Common/Text.h"
-#include "RegGen/Container/FlatSet.h"
+#include "RegGen/Common/ThreadPool.h"
+#include "RegGen/Container/Bitset.h"
 #include "RegGen/Container/SmallVector.h"
 #include "RegGen/Lexer/Regex.h"
 
 namespace RG {
 
-using PositionLabel = const LabelExpr*;
-using PositionSet = FlatSet<PositionLabel>;
+// add edges of src as sorted ranges, given the target state of each char class
+auto NewClassTransitions(LexerAutomaton& dfa, DfaState* src,
+                         const SmallVector<DfaState*>& class_targets) -> void {
+  const auto& classes = dfa.CharClasses();
 
-using RootExprVec = SmallVector<const RootExpr*>;
-using AcceptCategoryLookup =
-    std::unordered_map<PositionLabel, const TokenInfo*>;
+  for (int first = 0; first < CharClassMap::kAlphabetSize;) {
+    auto* target = class_targets[classes.Lookup(first)];
 
-struct JointRegexTree {
-  RootExprVec roots = {};
-  AcceptCategoryLookup acc_lookup = {};
-};
+    auto last = first;
+    while (last + 1 < CharClassMap::kAlphabetSize &&
+           class_targets[classes.Lookup(last + 1)] == target) {
+      last += 1;
+    }
 
-struct RegexNodeInfo {
-  // if the node can match empty string
-  bool nullable = false;
+    if (target != nullptr) {
+      dfa.NewTransition(src, target, CharRange{first, last});
+    }
+
+    first = last + 1;
+  }
+}
 
-  // set of initial positions of the node
-  PositionSet first_pos = {};
+// returns nullptr if more than state_limit states are needed, unless it is 0
+auto BuildDfaAutomaton(const PositionAutomaton& pa, int state_limit,
+                       ThreadPool* pool) -> std::unique_ptr<LexerAutomaton> {
+  // number of states whose targets are held at once
+  constexpr int kBatchSize = 256;
 
-  // set of terminal positions of the node
-  PositionSet last_pos = {};
-};
+  auto dfa = std::make_unique<LexerAutomaton>();
+  dfa->SetCharClasses(pa.char_classes);
 
-struct RegexEvalResult {
-  // extra information for each node
-  std::unordered_map<const RegexExpr*, const RegexNodeInfo> info_map = {};
+  const auto class_num = pa.char_classes.ClassCount();
 
-  // follow_pos set for each position
-  std::unordered_map<PositionLabel, PositionSet> follow_pos = {};
-};
+  // position sets are interned by hash, and kept by state id for expansion
+  SmallVector<DfaState*> dfa_states = {dfa->NewState()};
+  SmallVector<Bitset> position_sets = {pa.initial};
+  auto dfa_state_lookup =
+      std::unordered_map<Bitset, DfaState*, Bitset::Hash>{
+          {pa.initial, dfa_states.front()}};
+
+  // targets of a batch of states are computed in parallel, then interned in
+  // the order of source id and class, so that states are numbered exactly as
+  // a sequential breadth-first traversal would
+  //
+  // only the non-empty targets are kept, with their class
+  SmallVector<SmallVector<std::pair<int, Bitset>>> batch_targets;
+  SmallVector<DfaState*> class_targets(class_num, nullptr);
+  for (int begin = 0; begin < dfa->StateCount();) {
+    const auto end = std::min(dfa->StateCount(), begin + kBatchSize);
+
+    batch_targets.clear();
+    batch_targets.resize(end - begin);
+    ParallelFor(pool, end - begin, [&](int i) {
+      for (int cls = 0; cls < class_num; ++cls) {
+        auto dest_set = pa.ComputeTarget(position_sets[begin + i], cls);
+        if (dest_set.any()) {
+          batch_targets[i].emplace_back(cls, std::move(dest_set));
+        }
+      }
+    });
 
-struct RegexExprVisitImpl : public RegexExprVisitor {
-  std::unordered_map<const RegexExpr*, const RegexNodeInfo> info_map{};
-  std::unordered_map<PositionLabel, PositionSet> follow_pos{};
+    for (int i = 0; i < end - begin; ++i) {
+      std::fill(class_targets.begin(), class_targets.end(), nullptr);
 
-  const RegexNodeInfo* last_visited_info;
+      for (auto& [cls, dest_set] : batch_targets[i]) {
+        auto& dest_state = dfa_state_lookup[dest_set];
 
-  auto VisitRegexExprVec(const RegexExprVec& exprs)
-      -> SmallVector<const RegexNodeInfo*> {
-    SmallVector<const RegexNodeInfo*> result;
-    for (const auto& expr : exprs) {
-      expr->Accept(*this);
-      result.push_back(last_visited_info);
-    }
-    return result;
-  }
+        if (dest_state == nullptr) {
+          if (state_limit > 0 && dfa->StateCount() == state_limit) {
+            return nullptr;
+          }
 
-  auto UpdateNodeInfo(const RegexExpr& expr, const RegexNodeInfo& info)
-      -> void {
-    info_map.insert({&expr, info});
-    last_visited_info = &info_map.at(&expr);
-  }
+          auto acc_term = pa.ComputeAcceptCategory(dest_set);
+
+          dest_state = dfa->NewState(acc_term);
+
+          dfa_states.push_back(dest_state);
+          position_sets.push_back(std::move(dest_set));
+        }
+
+        class_targets[cls] = dest_state;
+      }
 
-  auto Visit(const RootExpr& expr) -> void override {
-    expr.Child()->Accept(*this);
-    const auto& child_info = *last_visited_info;
-    for (const auto* pos : child_info.last_pos) {
-      follow_pos[pos].insert(&expr);
+      NewClassTransitions(*dfa, dfa_states[begin + i], class_targets);
     }
-    UpdateNodeInfo(expr, {false, child_info.first_pos, {&expr}});
-  }
 
-  auto Visit(const EntityExpr& expr) -> void override {
-    UpdateNodeInfo(expr, {false, {&expr}, {&expr}});
+    begin = end;
   }
 
-  auto Visit(const SequenceExpr& expr) -> void override {
-    auto child_info = VisitRegexExprVec(expr.Child());
+  return dfa;
+}
 
-    bool nullable =
-        std::all_of(child_info.begin(), child_info.end(),
-                    [](const auto* info) { return info->nullable; });
+// refinable partition of dfa states used by Hopcroft's algorithm
+//
+// elements of a block are stored contiguously in elems_, marked elements are
+// moved to the front of their block so that a split is done in O(marked)
+class StatePartition {
+ public:
+  StatePartition(int state_num) {
+    elems_.resize(state_num);
+    location_.resize(state_num);
+    block_of_.resize(state_num, 0);
+
+    std::iota(elems_.begin(), elems_.end(), 0);
+    std::iota(location_.begin(), location_.end(), 0);
+  }
 
-    PositionSet first_pos = {};
-    PositionSet last_pos = {};
+  auto BlockCount() const -> int { return block_begin_.size(); }
+  auto BlockOf(int state) const -> int { return block_of_[state]; }
+  auto BlockSize(int block) const -> int {
+    return block_end_[block] - block_begin_[block];
+  }
+  auto BlockElements(int block) const -> SmallVector<int> {
+    return SmallVector<int>(elems_.begin() + block_begin_[block],
+                            elems_.begin() + block_end_[block]);
+  }
 
-    for (const auto* child : child_info) {
-      first_pos.insert(child->first_pos.begin(), child->first_pos.end());
+  // arrange states into initial blocks, states with the same key share a block
+  auto Initialize(const SmallVector<int>& keys) -> void {
+    std::stable_sort(elems_.begin(), elems_.end(),
+                     [&](int lhs, int rhs) { return keys[lhs] < keys[rhs]; });
 
-      if (!child->nullable) {
-        break;
+    for (int i = 0; i < elems_.size(); ++i) {
+      if (i == 0 || keys[elems_[i]] != keys[elems_[i - 1]]) {
+        block_begin_.push_back(i);
+        block_end_.push_back(i);
+        block_marked_.push_back(0);
       }
+
+      block_end_.back() = i + 1;
+      location_[elems_[i]] = i;
+      block_of_[elems_[i]] = BlockCount() - 1;
     }
+  }
 
-    for (auto it = child_info.rbegin(); it != child_info.rend(); ++it) {
-      last_pos.insert((*it)->last_pos.begin(), (*it)->last_pos.end());
+  auto Mark(int state) -> void {
+    auto block = block_of_[state];
+    auto boundary = block_begin_[block] + block_marked_[block];
 
-      if (!(*it)->nullable) {
-        break;
-      }
+    if (location_[state] < boundary) {
+      // already marked
+      return;
     }
 
-    const RegexNodeInfo* last_child_info = nullptr;
-    for (const auto* child : child_info) {
-      if (last_child_info) {
-        for (const auto* pos : last_child_info->last_pos) {
-          follow_pos[pos].insert(child->first_pos.begin(),
-                                 child->first_pos.end());
-        }
-      }
-      last_child_info = child;
+    if (block_marked_[block] == 0) {
+      touched_.push_back(block);
     }
-    UpdateNodeInfo(expr, {nullable, first_pos, last_pos});
-  }
-
-  auto Visit(const ChoiceExpr& expr) -> void override {
-    auto child_info = VisitRegexExprVec(expr.Child());
 
-    bool nullable =
-        std::any_of(child_info.begin(), child_info.end(),
-                    [](const auto* info) { return info->nullable; });
+    // swap state to the marked region
+    auto other = elems_[boundary];
+    std::swap(elems_[location_[state]], elems_[boundary]);
+    location_[other] = location_[state];
+    location_[state] = boundary;
 
-    PositionSet first_pos = {};
-    PositionSet last_pos = {};
+    block_marked_[block] += 1;
+  }
 
-    for (const auto* child : child_info) {
-      first_pos.insert(child->first_pos.begin(), child->first_pos.end());
-      last_pos.insert(child->last_pos.begin(), child->last_pos.end());
-    }
+  // split every touched block into its marked and unmarked part
+  // callback(old_block, new_block) is invoked for each split
+  template <typename F>
+  auto SplitTouched(F callback) -> void {
+    for (auto block : touched_) {
+      auto marked = block_marked_[block];
+      block_marked_[block] = 0;
 
-    UpdateNodeInfo(expr, {nullable, first_pos, last_pos});
-  }
+      if (marked == BlockSize(block)) {
+        continue;
+      }
 
-  auto Visit(const ClosureExpr& expr) -> void override {
-    expr.Child()->Accept(*this);
-    const auto& child_info = *last_visited_info;
+      // the marked part becomes a new block
+      auto new_block = BlockCount();
+      auto begin = block_begin_[block];
+      block_begin_.push_back(begin);
+      block_end_.push_back(begin + marked);
+      block_marked_.push_back(0);
+      block_begin_[block] = begin + marked;
 
-    auto stragegy = expr.Mode();
-    if (stragegy != RepetitionMode::Optional) {
-      for (const auto* pos : child_info.last_pos) {
-        follow_pos[pos].insert(child_info.first_pos.begin(),
-                               child_info.first_pos.end());
+      for (int i = begin; i < begin + marked; ++i) {
+        block_of_[elems_[i]] = new_block;
       }
+
+      callback(block, new_block);
     }
 
-    auto nullable = stragegy != RepetitionMode::Plus;
-    UpdateNodeInfo(expr, {nullable, child_info.first_pos, child_info.last_pos});
+    touched_.clear();
   }
-};
 
-auto CollectRegexNodeInfo(const RootExprVec& defs) -> RegexEvalResult {
-  RegexExprVisitImpl visitor{};
+ private:
+  SmallVector<int> elems_;
+  SmallVector<int> location_;
+  SmallVector<int> block_of_;
 
-  for (const auto& root : defs) {
-    root->Accept(visitor);
-  }
-
-  return RegexEvalResult{visitor.info_map, visitor.follow_pos};
-}
+  SmallVector<int> block_begin_;
+  SmallVector<int> block_end_;
+  SmallVector<int> block_marked_;
 
-auto ComputeInitialPositionSet(const RegexEvalResult& lookup,
-                               const RootExprVec& roots) -> PositionSet {
-  PositionSet result = {};
-  for (const auto& expr : roots) {
-    const auto& first_pos = lookup.info_map.at(expr).first_pos;
-    result.insert(first_pos.begin(), first_pos.end());
-  }
-  return result;
-}
+  SmallVector<int> touched_;
+};
 
-auto ComputeTargetPositionSet(const RegexEvalResult& lookup,
-                              const PositionSet& src, int ch) -> PositionSet {
-  PositionSet target = {};
-  for (const auto* pos : src) {
-    if (pos->TestPassage(ch)) {
-      const auto& t = lookup.follow_pos.at(pos);
-      target.insert(t.begin(), t.end());
+// merge equivalent states with Hopcroft's partition refinement
+//
+// missing transitions are treated as edges into an implicit sink state, which
+// is appended as the last state and dropped again after minimization
+auto MinimizeDfaAutomaton(const LexerAutomaton& dfa)
+    -> std::unique_ptr<LexerAutomaton> {
+  const auto state_num = dfa.StateCount() + 1;
+  const auto sink = state_num - 1;
+
+  const auto class_num = dfa.CharClasses().ClassCount();
+  const auto representatives = ComputeClassRepresentatives(dfa.CharClasses());
+
+  auto lookup_target = [&](int state, int cls) {
+    if (state != sink) {
+      const auto* src_state = dfa.LookupState(state);
+      if (const auto* target = src_state->LookupTransition(representatives[cls]);
+          target) {
+        return target->id;
+      }
     }
-  }
-  return target;
-}
 
-auto ComputeAcceptCategory(const AcceptCategoryLookup& lookup,
-                           const PositionSet& set) -> const TokenInfo* {
-  const TokenInfo* result = nullptr;
-  for (const auto* pos : set) {
-    auto iter = lookup.find(pos);
-    if (iter != lookup.end()) {
-      if (result == nullptr || result->Id() > iter->second->Id()) {
-        result = iter->second;
-      }
+    return sink;
+  };
+
+  // inverse transitions, indexed by class_num * target + cls
+  std::vector<SmallVector<int>> inverse(class_num * state_num);
+  for (int state = 0; state < state_num; ++state) {
+    for (int cls = 0; cls < class_num; ++cls) {
+      inverse[class_num * lookup_target(state, cls) + cls].push_back(state);
     }
   }
-  return result;
-}
 
-auto BuildDfaAutomaton(const JointRegexTree& trees)
-    -> std::unique_ptr<const LexerAutomaton> {
-  auto eval_result = CollectRegexNodeInfo(trees.roots);
-  auto initial_state = ComputeInitialPositionSet(eval_result, trees.roots);
+  // initial partition: states are distinguished by accepted token
+  SmallVector<int> keys;
+  for (int state = 0; state < state_num; ++state) {
+    const auto* acc_token =
+        state != sink ? dfa.LookupState(state)->acc_token : nullptr;
+    keys.push_back(acc_token ? acc_token->Id() : -1);
+  }
 
-  auto dfa = std::make_unique<LexerAutomaton>();
-  auto dfa_state_lookup =
-      std::map<PositionSet, DfaState*>{{initial_state, dfa->NewState()}};
+  StatePartition partition{state_num};
+  partition.Initialize(keys);
 
-  for (std::deque<PositionSet> unprocessed{initial_state}; !unprocessed.empty();
-       unprocessed.pop_front()) {
-    const auto& src_set = unprocessed.front();
-    const auto src_state = dfa_state_lookup.at(src_set);
+  SmallVector<int> worklist;
+  SmallVector<bool> in_worklist(partition.BlockCount(), true);
+  for (int block = 0; block < partition.BlockCount(); ++block) {
+    worklist.push_back(block);
+  }
 
-    for (int ch = 0; ch < 128; ++ch) {
-      auto dest_set = ComputeTargetPositionSet(eval_result, src_set, ch);
+  while (!worklist.empty()) {
+    auto splitter_block = worklist.back();
+    worklist.pop_back();
+    in_worklist[splitter_block] = false;
 
-      if (dest_set.empty()) {
-        continue;
+    const auto splitter = partition.BlockElements(splitter_block);
+    for (int cls = 0; cls < class_num; ++cls) {
+      for (auto target : splitter) {
+        for (auto src : inverse[class_num * target + cls]) {
+          partition.Mark(src);
+        }
       }
 
-      auto& dest_state = dfa_state_lookup[dest_set];
+      partition.SplitTouched([&](int old_block, int new_block) {
+        in_worklist.push_back(false);
 
-      if (dest_state == nullptr) {
-        auto acc_term = ComputeAcceptCategory(trees.acc_lookup, dest_set);
+        if (in_worklist[old_block] ||
+            partition.BlockSize(new_block) < partition.BlockSize(old_block)) {
+          worklist.push_back(new_block);
+          in_worklist[new_block] = true;
+        } else {
+          worklist.push_back(old_block);
+          in_worklist[old_block] = true;
+        }
+      });
+    }
+  }
 
-        dest_state = dfa->NewState(acc_term);
+  // renumber blocks in breadth-first order so the initial state stays 0
+  auto result = std::make_unique<LexerAutomaton>();
+  result->SetCharClasses(dfa.CharClasses());
+  result->SetUnminimizedStateCount(dfa.StateCount());
 
-        unprocessed.push_back(dest_set);
-      }
+  SmallVector<DfaState*> block_state(partition.BlockCount(), nullptr);
+  SmallVector<int> representative;
 
-      dfa->NewTransition(src_state, dest_state, ch);
+  const auto sink_block = partition.BlockOf(sink);
+  auto visit_block = [&](int state) -> DfaState* {
+    auto block = partition.BlockOf(state);
+    if (block == sink_block) {
+      return nullptr;
     }
-  }
 
-  return dfa;
-}
+    if (block_state[block] == nullptr) {
+      block_state[block] = result->NewState(dfa.LookupState(state)->acc_token);
+      representative.push_back(state);
+    }
 
-auto PrepareRegexBatch(const MetaInfo& info) {
-  JointRegexTree result;
+    return block_state[block];
+  };
 
-  auto process_token = [&](const TokenInfo& token) {
-    result.roots.push_back(token.TreeDefinition().get());
+  visit_block(0);
 
-    result.acc_lookup[result.roots.back()] = &token;
-  };
+  SmallVector<DfaState*> class_targets(class_num, nullptr);
+  for (int id = 0; id < representative.size(); ++id) {
+    auto* src_state = block_state[partition.BlockOf(representative[id])];
 
-  for (const auto& token : info.Tokens()) {
-    process_token(token);
-  }
+    for (int cls = 0; cls < class_num; ++cls) {
+      class_targets[cls] = visit_block(lookup_target(representative[id], cls));
+    }
 
-  for (const auto& token : info.IgnoredTokens()) {
-    process_token(token);
+    NewClassTransitions(*result, src_state, class_targets);
   }
 
   return result;
 }
 
+auto BuildLexerAutomaton(const PositionAutomaton& pa, int state_limit,
+                         ThreadPool* pool)
+    -> std::unique_ptr<const LexerAutomaton> {
+  auto dfa = BuildDfaAutomaton(pa, state_limit, pool);
+  if (dfa == nullptr) {
+    return nullptr;
+  }
+
+  return MinimizeDfaAutomaton(*dfa);
+}
+
 auto BuildLexerAutomaton(const MetaInfo& info)
     -> std::unique_ptr<const LexerAutomaton> {
-  auto joint_regex = PrepareRegexBatch(info);
-  return BuildDfaAutomaton(joint_regex);
+  return BuildLexerAutomaton(*BuildPositionAutomaton(info));
 }
 
 }  // namespace RG
\ No newline at end of file
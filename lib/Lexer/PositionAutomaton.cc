@@ -0,0 +1,313 @@
+#include "RegGen/Lexer/PositionAutomaton.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "RegGen/Common/Text.h"
+#include "RegGen/Parser/MetaInfo.h"
+
+namespace RG {
+
+using RootExprVec = SmallVector<const RootExpr*>;
+using AcceptCategoryLookup =
+    std::unordered_map<const LabelExpr*, const TokenInfo*>;
+
+struct JointRegexTree {
+  RootExprVec roots = {};
+  AcceptCategoryLookup acc_lookup = {};
+};
+
+struct RegexNodeInfo {
+  // if the node can match empty string
+  bool nullable = false;
+
+  // set of initial positions of the node
+  Bitset first_pos = {};
+
+  // set of terminal positions of the node
+  Bitset last_pos = {};
+};
+
+struct PositionCollector : public RegexExprVisitor {
+  SmallVector<const LabelExpr*> positions{};
+  std::unordered_map<const LabelExpr*, int> position_lookup{};
+
+  SmallVector<CharRange> ranges{};
+
+  auto NewPosition(const LabelExpr& expr) -> void {
+    position_lookup.insert({&expr, static_cast<int>(positions.size())});
+    positions.push_back(&expr);
+  }
+
+  auto Visit(const RootExpr& expr) -> void override {
+    expr.Child()->Accept(*this);
+    NewPosition(expr);
+  }
+
+  auto Visit(const EntityExpr& expr) -> void override {
+    NewPosition(expr);
+    ranges.push_back(expr.Range());
+  }
+
+  auto Visit(const SequenceExpr& expr) -> void override {
+    for (const auto& child : expr.Child()) {
+      child->Accept(*this);
+    }
+  }
+
+  auto Visit(const ChoiceExpr& expr) -> void override {
+    for (const auto& child : expr.Child()) {
+      child->Accept(*this);
+    }
+  }
+
+  auto Visit(const ClosureExpr& expr) -> void override {
+    expr.Child()->Accept(*this);
+  }
+};
+
+struct RegexExprVisitImpl : public RegexExprVisitor {
+  explicit RegexExprVisitImpl(const PositionCollector& collector)
+      : position_lookup(collector.position_lookup),
+        position_num(collector.positions.size()),
+        follow_pos(position_num, Bitset{position_num}) {}
+
+  const std::unordered_map<const LabelExpr*, int>& position_lookup;
+  int position_num;
+
+  SmallVector<Bitset> follow_pos;
+
+  RegexNodeInfo last_visited_info{};
+
+  auto MakePositionSet(const LabelExpr& expr) -> Bitset {
+    Bitset result{position_num};
+    result.set(position_lookup.at(&expr));
+    return result;
+  }
+
+  auto AppendFollow(const Bitset& last_pos, const Bitset& first_pos) -> void {
+    last_pos.for_each([&](int pos) { follow_pos[pos] |= first_pos; });
+  }
+
+  auto Visit(const RootExpr& expr) -> void override {
+    expr.Child()->Accept(*this);
+    auto child_info = std::move(last_visited_info);
+
+    auto self = MakePositionSet(expr);
+    AppendFollow(child_info.last_pos, self);
+
+    last_visited_info = {false, std::move(child_info.first_pos), self};
+  }
+
+  auto Visit(const EntityExpr& expr) -> void override {
+    auto self = MakePositionSet(expr);
+    last_visited_info = {false, self, self};
+  }
+
+  auto Visit(const SequenceExpr& expr) -> void override {
+    // fold children from left to right
+    RegexNodeInfo result{true, Bitset{position_num}, Bitset{position_num}};
+
+    for (const auto& child : expr.Child()) {
+      child->Accept(*this);
+      auto child_info = std::move(last_visited_info);
+
+      AppendFollow(result.last_pos, child_info.first_pos);
+
+      if (result.nullable) {
+        result.first_pos |= child_info.first_pos;
+      }
+
+      if (child_info.nullable) {
+        result.last_pos |= child_info.last_pos;
+      } else {
+        result.last_pos = std::move(child_info.last_pos);
+      }
+
+      result.nullable = result.nullable && child_info.nullable;
+    }
+
+    last_visited_info = std::move(result);
+  }
+
+  auto Visit(const ChoiceExpr& expr) -> void override {
+    RegexNodeInfo result{false, Bitset{position_num}, Bitset{position_num}};
+
+    for (const auto& child : expr.Child()) {
+      child->Accept(*this);
+      auto child_info = std::move(last_visited_info);
+
+      result.nullable = result.nullable || child_info.nullable;
+      result.first_pos |= child_info.first_pos;
+      result.last_pos |= child_info.last_pos;
+    }
+
+    last_visited_info = std::move(result);
+  }
+
+  auto Visit(const ClosureExpr& expr) -> void override {
+    expr.Child()->Accept(*this);
+    auto& child_info = last_visited_info;
+
+    auto stragegy = expr.Mode();
+    if (stragegy != RepetitionMode::Optional) {
+      AppendFollow(child_info.last_pos, child_info.first_pos);
+    }
+
+    child_info.nullable = stragegy != RepetitionMode::Plus;
+  }
+};
+
+auto CharClassMap::Compute(ArrayRef<CharRange> ranges) -> CharClassMap {
+  Array<int, kAlphabetSize> classes;
+  Array<int, 2 * kAlphabetSize> remap;
+  auto class_count = 1;
+
+  classes.fill(0);
+
+  // refine the partition by each range, a class is split into the part inside
+  // and the part outside of the range
+  for (auto rg : ranges) {
+    auto min = std::max(rg.Min(), 0);
+    auto max = std::min(rg.Max(), kAlphabetSize - 1);
+
+    remap.fill(-1);
+    for (int ch = min; ch <= max; ++ch) {
+      auto& target = remap[classes[ch]];
+      if (target == -1) {
+        target = class_count++;
+      }
+
+      classes[ch] = target;
+    }
+
+    // renumber classes in order of first occurrence so that ids stay dense
+    remap.fill(-1);
+    class_count = 0;
+    for (auto& cls : classes) {
+      if (remap[cls] == -1) {
+        remap[cls] = class_count++;
+      }
+
+      cls = remap[cls];
+    }
+  }
+
+  CharClassMap result;
+  result.class_count_ = class_count;
+  std::copy(classes.begin(), classes.end(), result.table_.begin());
+
+  return result;
+}
+
+auto ComputeClassRepresentatives(const CharClassMap& classes)
+    -> SmallVector<int> {
+  SmallVector<int> result(classes.ClassCount(), -1);
+  for (int ch = CharClassMap::kAlphabetSize - 1; ch >= 0; --ch) {
+    result[classes.Lookup(ch)] = ch;
+  }
+
+  return result;
+}
+
+auto BuildJointPositionAutomaton(const JointRegexTree& trees)
+    -> std::unique_ptr<PositionAutomaton> {
+  PositionCollector collector{};
+  for (const auto* root : trees.roots) {
+    root->Accept(collector);
+  }
+
+  const auto position_num = static_cast<int>(collector.positions.size());
+
+  RegexExprVisitImpl visitor{collector};
+  auto result = std::make_unique<PositionAutomaton>();
+
+  result->char_classes = CharClassMap::Compute(collector.ranges);
+  result->positions = collector.positions;
+  result->initial = Bitset{position_num};
+  for (const auto* root : trees.roots) {
+    root->Accept(visitor);
+    result->initial |= visitor.last_visited_info.first_pos;
+  }
+
+  result->follow = std::move(visitor.follow_pos);
+
+  // a class is consumed by a position if its representative is
+  const auto class_num = result->char_classes.ClassCount();
+  const auto representatives = ComputeClassRepresentatives(result->char_classes);
+
+  result->class_mask.assign(class_num, Bitset{position_num});
+  result->accept_mask = Bitset{position_num};
+  result->acc_token.assign(position_num, nullptr);
+
+  for (int pos = 0; pos < position_num; ++pos) {
+    const auto* label = result->positions[pos];
+
+    for (int cls = 0; cls < class_num; ++cls) {
+      if (label->TestPassage(representatives[cls])) {
+        result->class_mask[cls].set(pos);
+      }
+    }
+
+    if (auto it = trees.acc_lookup.find(label); it != trees.acc_lookup.end()) {
+      result->accept_mask.set(pos);
+      result->acc_token[pos] = it->second;
+    }
+  }
+
+  return result;
+}
+
+auto PositionAutomaton::ComputeTarget(const Bitset& src, int cls) const
+    -> Bitset {
+  Bitset target{PositionCount()};
+
+  auto matched = src;
+  matched &= class_mask[cls];
+  matched.for_each([&](int pos) { target |= follow[pos]; });
+
+  return target;
+}
+
+auto PositionAutomaton::ComputeAcceptCategory(const Bitset& set) const
+    -> const TokenInfo* {
+  const TokenInfo* result = nullptr;
+
+  auto accepted = set;
+  accepted &= accept_mask;
+  accepted.for_each([&](int pos) {
+    const auto* token = acc_token[pos];
+    if (result == nullptr || result->Id() > token->Id()) {
+      result = token;
+    }
+  });
+
+  return result;
+}
+
+auto PrepareRegexBatch(const MetaInfo& info) -> JointRegexTree {
+  JointRegexTree result;
+
+  auto process_token = [&](const TokenInfo& token) {
+    result.roots.push_back(token.TreeDefinition().get());
+
+    result.acc_lookup[result.roots.back()] = &token;
+  };
+
+  for (const auto& token : info.Tokens()) {
+    process_token(token);
+  }
+
+  for (const auto& token : info.IgnoredTokens()) {
+    process_token(token);
+  }
+
+  return result;
+}
+
+auto BuildPositionAutomaton(const MetaInfo& info)
+    -> std::unique_ptr<const PositionAutomaton> {
+  return BuildJointPositionAutomaton(PrepareRegexBatch(info));
+}
+
+}  // namespace RG
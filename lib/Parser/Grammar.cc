@@ -1,6 +1,7 @@
 #include "RegGen/Parser/Grammar.h"
 
 #include <cassert>
+#include <vector>
 
 namespace RG {
 
@@ -30,7 +31,9 @@ auto GrammarBuilder::MakeTerminal(const TokenInfo* info,
   auto key = SymbolKey{info, version};
   auto iter = lookup.find(key);
   if (iter == lookup.end()) {
-    iter = lookup.try_emplace(iter, key, Terminal{info, version});
+    const int id = site_->term_list_.size();
+    iter = lookup.try_emplace(iter, key, Terminal{info, version, id});
+    site_->term_list_.push_back(&iter->second);
   }
 
   return &iter->second;
@@ -44,7 +47,9 @@ auto GrammarBuilder::MakeNonterminal(const VariableInfo* info,
   auto key = SymbolKey{info, version};
   auto iter = lookup.find({info, version});
   if (iter == lookup.end()) {
-    iter = lookup.try_emplace(iter, key, Nonterminal{info, version});
+    const int id = site_->nonterm_list_.size();
+    iter = lookup.try_emplace(iter, key, Nonterminal{info, version, id});
+    site_->nonterm_list_.push_back(&iter->second);
   }
 
   return &iter->second;
@@ -81,115 +86,179 @@ auto GrammarBuilder::Build(Nonterminal* root) -> std::unique_ptr<Grammar> {
   return std::move(site_);
 }
 
-// try to insert FIRST SET of s into output
-static auto TryInsertFIRST(TerminalSet& output, Symbol* s) -> bool {
-  // remember output's size
-  const auto old_output_sz = output.size();
+namespace {
 
-  // try insert terminals that start s into output
-  if (auto* term = s->AsTerminal(); term) {
-    output.insert(term);
-  } else {
-    const auto& source_set = s->AsNonterminal()->FirstSet();
-    output.insert(source_set.begin(), source_set.end());
+// nonterminals whose changes are yet to be propagated, each queued at most
+// once at a time
+class Worklist {
+ public:
+  explicit Worklist(int var_num) : queued_(var_num) {}
+
+  auto Empty() const -> bool { return vars_.empty(); }
+
+  auto Push(Nonterminal* var) -> void {
+    if (!queued_.test(var->Id())) {
+      queued_.set(var->Id());
+      vars_.push_back(var);
+    }
   }
 
-  // return if output is changed
-  return output.size() != old_output_sz;
-}
+  auto Pop() -> Nonterminal* {
+    auto* var = vars_.back();
+    vars_.pop_back();
+    queued_.reset(var->Id());
 
-// try to insert FOLLOW SET of s into output
-static auto TryInsertFOLLOW(TerminalSet& output, const Nonterminal* s) -> bool {
-  // remember output's size
-  const auto old_output_sz = output.size();
+    return var;
+  }
 
-  // try insert terminals that may follow s into output
-  output.insert(s->FollowSet().begin(), s->FollowSet().end());
+ private:
+  SmallVector<Nonterminal*> vars_;
+  Bitset queued_;
+};
 
-  // return if output is changed
-  return output.size() != old_output_sz;
-}
+}  // namespace
 
 auto GrammarBuilder::ComputeFirstSet() -> void {
-  // iteratively compute first set until it's not growing
-  for (auto growing = true; growing;) {
-    growing = false;
+  const auto& productions = site_->productions_;
+  const int term_num = site_->term_list_.size();
+  const int var_num = site_->nonterm_list_.size();
 
-    for (const auto& production : site_->productions_) {
-      auto& lhs = production->lhs_;
+  for (auto* var : site_->nonterm_list_) {
+    var->first_set_.resize(term_num);
+  }
 
-      bool may_produce_epsilon = true;
-      for (const auto rhs_elem : production->rhs_) {
-        growing |= TryInsertFIRST(lhs->first_set_, rhs_elem);
+  // a production derives epsilon once every symbol on its right side does,
+  // count down the symbols not yet known to, terminals never do
+  SmallVector<int> pending(productions.size());
+  std::vector<SmallVector<int>> occurrences(var_num);
+  Worklist worklist{var_num};
+  for (int i = 0; i < productions.size(); ++i) {
+    const auto& production = productions[i];
+
+    pending[i] = production->rhs_.size();
+    for (auto* s : production->rhs_) {
+      if (auto* nonterm = s->AsNonterminal(); nonterm) {
+        occurrences[nonterm->Id()].push_back(i);
+      }
+    }
 
-        // break on first non-epsilon-derivable symbol
+    // NOTE empty production also indicates epsilon
+    if (pending[i] == 0 && !production->lhs_->may_produce_epsilon_) {
+      production->lhs_->may_produce_epsilon_ = true;
+      worklist.Push(production->lhs_);
+    }
+  }
 
-        if (rhs_elem->AsTerminal() ||
-            !rhs_elem->AsNonterminal()->may_produce_epsilon_) {
-          may_produce_epsilon = false;
-          break;
-        }
+  while (!worklist.Empty()) {
+    auto* var = worklist.Pop();
+    for (auto i : occurrences[var->Id()]) {
+      auto* lhs = productions[i]->lhs_;
+      if (--pending[i] == 0 && !lhs->may_produce_epsilon_) {
+        lhs->may_produce_epsilon_ = true;
+        worklist.Push(lhs);
       }
+    }
+  }
 
-      if (may_produce_epsilon && !lhs->may_produce_epsilon_) {
-        // as the iteration didn't break early
-        // it may produce epsilon symbol
-        // NOTE empty production also indicates epsilon
-        growing = true;
-        lhs->may_produce_epsilon_ = true;
+  // FIRST(lhs) includes FIRST of every symbol up to the first one not
+  // deriving epsilon, seed with the terminals and record the rest as edges
+  std::vector<SmallVector<Nonterminal*>> dependents(var_num);
+  for (const auto& production : productions) {
+    auto* lhs = production->lhs_;
+
+    for (auto* s : production->rhs_) {
+      if (auto* term = s->AsTerminal(); term) {
+        lhs->first_set_.set(term->Id());
+        break;
+      }
+
+      auto* nonterm = s->AsNonterminal();
+      if (nonterm != lhs) {
+        dependents[nonterm->Id()].push_back(lhs);
+      }
+      if (!nonterm->may_produce_epsilon_) {
+        break;
+      }
+    }
+  }
+
+  for (auto* var : site_->nonterm_list_) {
+    if (var->first_set_.any()) {
+      worklist.Push(var);
+    }
+  }
+  while (!worklist.Empty()) {
+    auto* var = worklist.Pop();
+    for (auto* dependent : dependents[var->Id()]) {
+      if (dependent->first_set_.unite(var->first_set_)) {
+        worklist.Push(dependent);
       }
     }
   }
 }
 
 auto GrammarBuilder::ComputeFollowSet() -> void {
+  const int term_num = site_->term_list_.size();
+  const int var_num = site_->nonterm_list_.size();
+
+  for (auto* var : site_->nonterm_list_) {
+    var->follow_set_.resize(term_num);
+  }
+
   // NOTE root symbol always preceeds eof
   site_->root_symbol_->may_preceed_eof_ = true;
 
-  // iteratively compute follow set until it's not growing
-  for (auto growing = true; growing;) {
-    growing = false;
-
-    for (const auto& production : site_->productions_) {
-      // shortcuts alias
-      const auto& lhs = production->lhs_;
-      const auto& rhs = production->rhs_;
-
-      // epsilon_path is set false when any non-nullable symbol is encountered
-      bool epsilon_path = true;
-      for (auto iter = rhs.rbegin(); iter != rhs.rend(); ++iter) {
-        const auto& current_symbol = *iter;
-
-        // process lookahead symbol
-        if (const auto next_iter = next(iter); next_iter != rhs.rend()) {
-          const auto next_symbol = *next_iter;
-          if (auto* nonterm = next_symbol->AsNonterminal(); nonterm) {
-            growing |= TryInsertFIRST(nonterm->follow_set_, current_symbol);
-          }
-        }
-
-        // process current symbol
-        if (epsilon_path) {
-          if (auto* current_nonterm = current_symbol->AsNonterminal();
-              current_nonterm) {
-            if (!current_nonterm->may_produce_epsilon_) {
-              epsilon_path = false;
-            }
-
-            // propagate may_preceed_eof on epsilon path
-            if (!current_nonterm->may_preceed_eof_ && lhs->may_preceed_eof_) {
-              growing = true;
-              current_nonterm->may_preceed_eof_ = true;
-            }
-
-            // propagate follow_set on epsilon path
-            growing |= TryInsertFOLLOW(current_nonterm->follow_set_, lhs);
-          } else {
-            epsilon_path = false;
-          }
-        }
+  // FOLLOW(s) includes FIRST of what comes after s, and FOLLOW(lhs) if that
+  // may derive epsilon, the latter recorded as edges
+  std::vector<SmallVector<Nonterminal*>> dependents(var_num);
+  Bitset trailing_first{term_num};
+  for (const auto& production : site_->productions_) {
+    auto* lhs = production->lhs_;
+    const auto& rhs = production->rhs_;
+
+    // walk backwards, tracking FIRST of the suffix and if it may vanish
+    auto epsilon_path = true;
+    trailing_first.clear();
+    for (auto iter = rhs.rbegin(); iter != rhs.rend(); ++iter) {
+      if (auto* term = (*iter)->AsTerminal(); term) {
+        epsilon_path = false;
+        trailing_first.clear();
+        trailing_first.set(term->Id());
+        continue;
+      }
+
+      auto* nonterm = (*iter)->AsNonterminal();
+      nonterm->follow_set_ |= trailing_first;
+      if (epsilon_path && nonterm != lhs) {
+        dependents[lhs->Id()].push_back(nonterm);
+      }
+
+      if (!nonterm->may_produce_epsilon_) {
+        epsilon_path = false;
+        trailing_first.clear();
+      }
+      trailing_first |= nonterm->first_set_;
+    }
+  }
+
+  Worklist worklist{var_num};
+  for (auto* var : site_->nonterm_list_) {
+    worklist.Push(var);
+  }
+  while (!worklist.Empty()) {
+    auto* var = worklist.Pop();
+    for (auto* dependent : dependents[var->Id()]) {
+      auto changed = dependent->follow_set_.unite(var->follow_set_);
+      if (var->may_preceed_eof_ && !dependent->may_preceed_eof_) {
+        dependent->may_preceed_eof_ = true;
+        changed = true;
+      }
+
+      if (changed) {
+        worklist.Push(dependent);
       }
     }
   }
 }
-}  // namespace RG
\ No newline at end of file
+
+}  // namespace RG
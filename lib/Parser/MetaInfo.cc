@@ -4,6 +4,7 @@
 #include <cassert>
 #include <sstream>
 
+#include "RegGen/Common/BinaryStream.h"
 #include "RegGen/Common/Configuration.h"
 #include "RegGen/Common/TypeDefinition.h"
 #include "RegGen/Parser/TypeInfo.h"
@@ -24,6 +25,16 @@ class MetaInfo::Builder {
     return Finalize();
   }
 
+  // loads what SerializeParserInfo wrote, types and regex trees are absent
+  auto Load(BinaryReader& reader, const AST::ASTTypeProxyManager* env)
+      -> std::unique_ptr<MetaInfo> {
+    Initialize("", env);
+
+    LoadSymbolSkeleton(reader);
+
+    return Finalize();
+  }
+
  private:
   auto Initialize(const std::string& /*config*/,
                   const AST::ASTTypeProxyManager* env) -> void {
@@ -57,6 +68,14 @@ class MetaInfo::Builder {
     site_->symbol_lookup_[info->Name()] = info;
   }
 
+  auto LookupTokenInfo(const std::string& name) -> TokenInfo* {
+    auto it = site_->symbol_lookup_.find(name);
+    Assert(it != site_->symbol_lookup_.end() && it->second->IsToken(),
+           "ParserMetaInfo::Builder: precedence of an unknown token.");
+
+    return static_cast<TokenInfo*>(it->second);
+  }
+
   auto TranslateTypeSpec(const QualType& def) -> TypeSpec {
     using Qualifier = TypeSpec::Qualifier;
 
@@ -202,7 +221,8 @@ class MetaInfo::Builder {
                             ? site_->env_->Lookup(rule_type_info->Name())
                             : &AST::DummyASTTypeProxy::Instance();
 
-    return std::make_unique<AST::ASTHandle>(proxy, gen_handle,
+    return std::make_unique<AST::ASTHandle>(rule_type_info->Name(), proxy,
+                                            gen_handle,
                                             std::move(manip_handle));
   }
 
@@ -280,6 +300,22 @@ class MetaInfo::Builder {
 
       RegisterSymbolInfo(&info);
     }
+    for (int i = 0; i < config.precedences.size(); ++i) {
+      const auto& def = config.precedences[i];
+      auto assoc = def.assoc == "left"    ? Associativity::Left
+                   : def.assoc == "right" ? Associativity::Right
+                                          : Associativity::NonAssoc;
+
+      for (const auto& name : def.tokens) {
+        auto* info = LookupTokenInfo(name);
+        Assert(info->precedence_ == 0,
+               "ParserMetaInfo::Builder: duplicate precedence declaration.");
+
+        info->precedence_ = i + 1;
+        info->assoc_ = assoc;
+      }
+    }
+
     ignored_tokens.initialize(config.ignored_tokens.size());
     for (int i = 0; i < ignored_tokens.size(); ++i) {
       const auto& def = config.ignored_tokens[i];
@@ -316,12 +352,144 @@ class MetaInfo::Builder {
 
         info.handle_ = ConstructAstHandle(lhs->type_, rule_item);
 
+        if (!rule_item.precedence.empty()) {
+          info.precedence_ = LookupTokenInfo(rule_item.precedence);
+        } else {
+          for (const auto* symbol : info.rhs_) {
+            if (const auto* tok = symbol->AsToken(); tok) {
+              info.precedence_ = tok;
+            }
+          }
+        }
+
         // inject ProductionInfo back into VariableInfo
         lhs->productions_.push_back(&info);
       }
     }
   }
 
+  auto LoadTokenSkeleton(BinaryReader& reader, HeapArray<TokenInfo>& tokens,
+                         int first_id) -> void {
+    tokens.initialize(reader.ReadCount(kMaxSkeletonCount));
+    for (int i = 0; i < tokens.size(); ++i) {
+      auto& info = tokens[i];
+
+      info = TokenInfo(first_id + i, reader.ReadString());
+      info.text_def_ = reader.ReadString();
+    }
+  }
+
+  auto LoadHandleSkeleton(BinaryReader& reader, int rhs_size)
+      -> std::unique_ptr<AST::ASTHandle> {
+    auto type_name = reader.ReadString();
+
+    auto gen_handle = [&]() -> AST::ASTHandle::GenHandle {
+      switch (reader.ReadInt()) {
+        case 0:
+          return AST::ASTEnumGen{reader.ReadInt()};
+        case 1:
+          return AST::ASTObjectGen{};
+        case 2:
+          return AST::ASTVectorGen{};
+        case 3:
+          return AST::ASTOptionalGen{};
+        case 4:
+          // an empty production has no item to select
+          if (rhs_size == 0) {
+            break;
+          }
+          return AST::ASTItemSelector{reader.ReadCount(rhs_size - 1)};
+        default:
+          break;
+      }
+
+      throw ParserConstructionError{
+          "ParserMetaInfo::Builder: invalid generator handle."};
+    }();
+
+    auto manip_handle = [&]() -> AST::ASTHandle::ManipHandle {
+      switch (reader.ReadInt()) {
+        case 0:
+          return AST::ASTManipPlaceholder{};
+        case 1: {
+          SmallVector<AST::ASTObjectSetter::SetterPair> setters;
+          setters.resize(reader.ReadCount(rhs_size));
+          for (auto& setter : setters) {
+            setter.member_index = reader.ReadCount(kMaxSkeletonCount);
+            setter.symbol_index = reader.ReadCount(rhs_size - 1);
+          }
+          return AST::ASTObjectSetter{setters};
+        }
+        case 2: {
+          SmallVector<int> indices;
+          indices.resize(reader.ReadCount(rhs_size));
+          for (auto& index : indices) {
+            index = reader.ReadCount(rhs_size - 1);
+          }
+          return AST::ASTVectorMerger{indices};
+        }
+        default:
+          throw ParserConstructionError{
+              "ParserMetaInfo::Builder: invalid manipulator handle."};
+      }
+    }();
+
+    const auto* proxy = site_->env_ ? site_->env_->Lookup(type_name)
+                                    : &AST::DummyASTTypeProxy::Instance();
+
+    return std::make_unique<AST::ASTHandle>(std::move(type_name), proxy,
+                                            gen_handle,
+                                            std::move(manip_handle));
+  }
+
+  auto LoadSymbolSkeleton(BinaryReader& reader) -> void {
+    auto& tokens = site_->tokens_;
+    auto& ignored_tokens = site_->ignored_tokens_;
+    auto& variables = site_->variables_;
+    auto& productions = site_->productions_;
+
+    LoadTokenSkeleton(reader, tokens, 0);
+    LoadTokenSkeleton(reader, ignored_tokens, tokens.size());
+    for (auto& info : tokens) {
+      RegisterSymbolInfo(&info);
+    }
+
+    variables.initialize(reader.ReadCount(kMaxSkeletonCount));
+    Assert(!variables.empty(), "ParserMetaInfo::Builder: no variable.");
+    for (int i = 0; i < variables.size(); ++i) {
+      auto& info = variables[i];
+
+      info = VariableInfo(i, reader.ReadString());
+      info.type_ = TypeSpec{TypeSpec::Qualifier::None, nullptr};
+
+      RegisterSymbolInfo(&info);
+    }
+
+    const auto symbol_num = tokens.size() + variables.size();
+
+    productions.initialize(reader.ReadCount(kMaxSkeletonCount));
+    for (auto& info : productions) {
+      info.lhs_ = &variables[reader.ReadCount(variables.size() - 1)];
+
+      auto rhs_size = reader.ReadCount(kMaxSkeletonCount);
+      for (int i = 0; i < rhs_size; ++i) {
+        auto symbol = reader.ReadCount(symbol_num - 1);
+        if (symbol < tokens.size()) {
+          info.rhs_.push_back(&tokens[symbol]);
+        } else {
+          info.rhs_.push_back(&variables[symbol - tokens.size()]);
+        }
+      }
+
+      info.handle_ = LoadHandleSkeleton(reader, rhs_size);
+
+      info.lhs_->productions_.push_back(&info);
+    }
+  }
+
+  // upper bound of element counts in serialized info
+  static constexpr int kMaxSkeletonCount = 1 << 24;
+
   std::unique_ptr<MetaInfo> site_;
 };
 
@@ -333,4 +501,70 @@ auto ResolveParserInfo(const std::string& config,
   return builder.Build(config, env);
 }
 
+auto SerializeParserInfo(BinaryWriter& writer, const MetaInfo& info) -> void {
+  auto write_tokens = [&](const HeapArray<TokenInfo>& tokens) {
+    writer.WriteInt(tokens.size());
+    for (const auto& token : tokens) {
+      writer.WriteString(token.Name());
+      writer.WriteString(token.TextDefinition());
+    }
+  };
+
+  write_tokens(info.Tokens());
+  write_tokens(info.IgnoredTokens());
+
+  writer.WriteInt(info.Variables().size());
+  for (const auto& variable : info.Variables()) {
+    writer.WriteString(variable.Name());
+  }
+
+  // tokens are followed by variables in symbol encoding
+  const auto token_num = static_cast<int>(info.Tokens().size());
+
+  writer.WriteInt(info.Productions().size());
+  for (const auto& production : info.Productions()) {
+    writer.WriteInt(production.Left()->Id());
+
+    writer.WriteInt(production.Right().size());
+    for (const auto* symbol : production.Right()) {
+      writer.WriteInt(symbol->IsToken() ? symbol->Id()
+                                        : token_num + symbol->Id());
+    }
+
+    const auto& handle = *production.Handle();
+    writer.WriteString(handle.TypeName());
+
+    const auto& gen = handle.Generator();
+    writer.WriteInt(gen.index());
+    if (const auto* enum_gen = std::get_if<AST::ASTEnumGen>(&gen)) {
+      writer.WriteInt(enum_gen->Value());
+    } else if (const auto* selector = std::get_if<AST::ASTItemSelector>(&gen)) {
+      writer.WriteInt(selector->Index());
+    }
+
+    const auto& manip = handle.Manipulator();
+    writer.WriteInt(manip.index());
+    if (const auto* setter = std::get_if<AST::ASTObjectSetter>(&manip)) {
+      writer.WriteInt(setter->Setters().size());
+      for (auto pair : setter->Setters()) {
+        writer.WriteInt(pair.member_index);
+        writer.WriteInt(pair.symbol_index);
+      }
+    } else if (const auto* merger = std::get_if<AST::ASTVectorMerger>(&manip)) {
+      writer.WriteInt(merger->Indices().size());
+      for (auto index : merger->Indices()) {
+        writer.WriteInt(index);
+      }
+    }
+  }
+}
+
+auto DeserializeParserInfo(BinaryReader& reader,
+                           const AST::ASTTypeProxyManager* env)
+    -> std::unique_ptr<MetaInfo> {
+  MetaInfo::Builder builder{};
+
+  return builder.Load(reader, env);
+}
+
 }  // namespace RG
\ No newline at end of file
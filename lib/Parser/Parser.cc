@@ -1,23 +1,112 @@
 #include "RegGen/Parser/Parser.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <variant>
 
 #include "RegGen/CodeGen/CppEmitter.h"
 #include "RegGen/Common/Format.h"
+#include "RegGen/Common/ThreadPool.h"
+#include "RegGen/Container/Array.h"
 #include "RegGen/Container/SmallVector.h"
+#include "RegGen/Container/SpscRing.h"
 #include "RegGen/Lexer/LexerAutomaton.h"
 #include "RegGen/Parser/MetaInfo.h"
 #include "RegGen/Parser/ParserAutomaton.h"
 
 namespace RG {
 
+// emits the lexer automaton as a switch/goto state machine, each state is a
+// label that records the token it accepts and dispatches on the next byte
+auto EmitDirectScanner(CppEmitter& e, const LexerAutomaton& dfa) -> void {
+  SmallVector<bool> targeted(dfa.StateCount(), false);
+  for (int id = 0; id < dfa.StateCount(); ++id) {
+    for (const auto& edge : dfa.LookupState(id)->transitions) {
+      targeted[edge.target->id] = true;
+    }
+  }
+
+  auto func_name =
+      "inline BasicASTToken ScanToken(std::string_view data, int offset)";
+  e.Block(func_name, [&]() {
+    e.WriteLine("const char* const begin = data.data() + offset;");
+    e.WriteLine("const char* const end = data.data() + data.size();");
+    e.WriteLine("const char* p = begin;");
+    e.WriteLine("const char* last_acc = nullptr;");
+    e.WriteLine("int last_acc_token = -1;");
+
+    for (int id = 0; id < dfa.StateCount(); ++id) {
+      const auto* state = dfa.LookupState(id);
+
+      e.EmptyLine();
+      if (targeted[id]) {
+        e.WriteLine("s{}:", id);
+      }
+
+      if (state->acc_token) {
+        e.WriteLine("last_acc = p;");
+        e.WriteLine("last_acc_token = {};", state->acc_token->Id());
+      }
+
+      if (state->transitions.empty()) {
+        e.WriteLine("goto done;");
+        continue;
+      }
+
+      e.WriteLine("if (p == end) goto done;");
+      e.Block("switch (static_cast<unsigned char>(*p++))", [&]() {
+        for (const auto& edge : state->transitions) {
+          // a few case labels a line
+          std::string labels;
+          auto label_num = 0;
+          for (int ch = edge.range.Min(); ch <= edge.range.Max(); ++ch) {
+            if (label_num == 6) {
+              e.WriteLine("{}", labels);
+              labels.clear();
+              label_num = 0;
+            }
+
+            labels.append(label_num == 0 ? "" : " ");
+            labels.append(Format("case {}:", ch));
+            label_num += 1;
+          }
+
+          if (label_num > 4) {
+            e.WriteLine("{}", labels);
+            e.WriteLine("  goto s{};", edge.target->id);
+          } else {
+            e.WriteLine("{} goto s{};", labels, edge.target->id);
+          }
+        }
+
+        e.WriteLine("default: goto done;");
+      });
+    }
+
+    e.EmptyLine();
+    e.WriteLine("done:");
+    e.WriteLine("if (last_acc == nullptr) return BasicASTToken{{}};");
+    e.WriteLine(
+        "return BasicASTToken{{offset, static_cast<int>(last_acc - begin), "
+        "last_acc_token}};");
+  });
+}
+
 auto BootstrapParser(const std::string& config) -> std::string {
   auto info = ResolveParserInfo(config, nullptr);
+  auto dfa = BuildLexerAutomaton(*info);
 
   CppEmitter e;
 
   e.WriteLine("#pragma once");
+  e.Include("string_view", true);
   e.Include("RegGen/RegGenInclude.h", false);
 
   e.EmptyLine();
@@ -37,7 +126,8 @@ auto BootstrapParser(const std::string& config) -> std::string {
     e.WriteLine("using RG::AST::BasicASTTypeProxy;");
     e.WriteLine("using RG::AST::ASTTypeProxyManager;");
 
-    e.WriteLine("using eds::loli::BasicParser;");
+    e.WriteLine("using RG::BasicParser;");
+    e.WriteLine("using RG::ParserOptions;");
 
     e.EmptyLine();
     e.Comment("Forward declarations");
@@ -138,6 +228,12 @@ auto BootstrapParser(const std::string& config) -> std::string {
       });
     }
 
+    e.EmptyLine();
+    e.Comment("Direct-coded scanner");
+
+    e.EmptyLine();
+    EmitDirectScanner(e, *dfa);
+
     e.EmptyLine();
     e.Comment("Environment");
 
@@ -181,8 +277,11 @@ auto BootstrapParser(const std::string& config) -> std::string {
 
       // parser
       e.EmptyLine();
-      e.WriteLine("return BasicParser<{}>::Create(config, &proxy_manager);",
-                  root_name);
+      e.WriteLine("ParserOptions options;");
+      e.WriteLine("options.scanner = &ScanToken;");
+      e.WriteLine(
+          "return BasicParser<{}>::Create(config, &proxy_manager, options);",
+          root_name);
     });
   });
 
@@ -205,15 +304,15 @@ class ParserContext {
     ast_stack_.push_back(value);
   }
 
-  auto ExecuteReduce(const ProductionInfo& production) -> AST::ASTItem {
-    const auto count = production.Right().size();
+  auto ExecuteReduce(int count, const AST::ASTHandle& handle)
+      -> AST::ASTItem {
     for (auto i = 0; i < count; ++i) {
       state_stack_.pop_back();
     }
 
     auto ref = ArrayRef<AST::ASTItem>(ast_stack_.data(), ast_stack_.size())
                    .take_back(count);
-    auto result = production.Handle()->Invoke(arena_, ref);
+    auto result = handle.Invoke(arena_, ref);
 
     for (auto i = 0; i < count; ++i) {
       ast_stack_.pop_back();
@@ -238,95 +337,374 @@ class ParserContext {
   SmallVector<AST::ASTItem> ast_stack_ = {};
 };
 
+CompiledGrammar::CompiledGrammar(const std::string& config,
+                                 const AST::ASTTypeProxyManager* env,
+                                 const ParserOptions& options) {
+  Initialize(config, env, options);
+}
+
 GenericParser::GenericParser(const std::string& config,
-                             const AST::ASTTypeProxyManager* env) {
-  Initialize(config, env);
+                             const AST::ASTTypeProxyManager* env,
+                             const ParserOptions& options)
+    : grammar_(std::make_shared<CompiledGrammar>(config, env, options)) {}
+
+GenericParser::GenericParser(std::shared_ptr<const CompiledGrammar> grammar)
+    : grammar_(std::move(grammar)) {
+  assert(grammar_ != nullptr);
+}
+
+auto GenericParser::Initialize(const std::string& config,
+                               const AST::ASTTypeProxyManager* env,
+                               const ParserOptions& options) -> void {
+  grammar_ = std::make_shared<CompiledGrammar>(config, env, options);
 }
 
-auto TranslateAction(PdaEdge action) -> ParserAction {
+auto TranslateAction(const MetaInfo& info, PdaEdge action) -> PackedAction {
   struct Visitor {
-    auto operator()(PdaEdgeReduce edge) -> ParserAction {
-      return ActionReduce{edge.production};
+    const MetaInfo& info;
+
+    auto operator()(PdaEdgeReduce edge) -> PackedAction {
+      return PackReduceAction(edge.production - info.Productions().begin());
+    }
+    auto operator()(PdaEdgeShift edge) -> PackedAction {
+      return PackShiftAction(edge.target->Id());
     }
-    auto operator()(PdaEdgeShift edge) -> ParserAction {
-      return ActionShift{edge.target->Id()};
+    auto operator()(PdaEdgeError /*edge*/) -> PackedAction {
+      return kPackedActionError;
     }
   };
 
-  return visit(Visitor{}, action);
+  return visit(Visitor{info}, action);
 }
 
-auto GenericParser::Initialize(const std::string& config,
-                               const AST::ASTTypeProxyManager* env) -> void {
+// most frequent value of a row other than ignored, or fallback if none
+auto ChooseDefaultEntry(ArrayRef<int32_t> row, int32_t ignored,
+                        int32_t fallback) -> int32_t {
+  auto sorted = SmallVector<int32_t>(row.begin(), row.end());
+  std::sort(sorted.begin(), sorted.end());
+
+  auto result = fallback;
+  auto result_count = 0;
+  for (auto it = sorted.begin(); it != sorted.end();) {
+    auto next = std::upper_bound(it, sorted.end(), *it);
+    if (*it != ignored && next - it > result_count) {
+      result = *it;
+      result_count = next - it;
+    }
+
+    it = next;
+  }
+
+  return result;
+}
+
+namespace {
+
+auto ElapsedMs(std::chrono::steady_clock::time_point since) -> double {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - since)
+      .count();
+}
+
+}  // namespace
+
+auto CompiledGrammar::Initialize(const std::string& config,
+                                 const AST::ASTTypeProxyManager* env,
+                                 const ParserOptions& options) -> void {
   assert(!config.empty() && env != nullptr);
 
-  info_ = ResolveParserInfo(config, env);
+  const auto start = std::chrono::steady_clock::now();
+  timings_ = {};
 
-  auto dfa = BuildLexerAutomaton(*info_);
-  auto pda = BuildLALRAutomaton(*info_);
+  info_ = ResolveParserInfo(config, env);
+  timings_.resolve_ms = ElapsedMs(start);
 
   token_num_ = info_->Tokens().size() + info_->IgnoredTokens().size();
   term_num_ = info_->Tokens().size();
   nonterm_num_ = info_->Variables().size();
+  pipeline_threshold_ = options.pipeline_threshold;
+
+  // both only read info_ and write disjoint members
+  const auto build_lexer = [&] {
+    nfa_ = nullptr;
+    scanner_ = options.scanner;
+    dfa_state_num_ = 0;
+    nul_ends_match_ = false;
+
+    if (scanner_ != nullptr) {
+      // a generated scanner needs no lexer automaton at all
+      lexer_mode_ = LexerMode::Direct;
+      position_automaton_ = nullptr;
+      char_classes_ = CharClassMap{};
+      char_class_num_ = char_classes_.ClassCount();
+    } else {
+      InitializeLexer(options);
+    }
+  };
 
-  dfa_state_num_ = dfa->StateCount();
-  pda_state_num_ = pda->States().size();
+  const auto build_parser = [&] {
+    const auto parser_start = std::chrono::steady_clock::now();
 
-  // lexing table
-  acc_token_lookup_.initialize(dfa->StateCount(), nullptr);
-  lexing_table_.initialize(128 * dfa_state_num_, -1);
+    LALROptions lalr_options;
+    lalr_options.eliminate_unit_productions =
+        options.eliminate_unit_productions;
+    lalr_options.thread_pool = options.thread_pool;
 
-  // parsing table
-  eof_action_table_.initialize(pda_state_num_, ActionError{});
-  action_table_.initialize(pda_state_num_ * term_num_, ActionError{});
-  goto_table_.initialize(pda_state_num_ * nonterm_num_, -1);
+    auto pda = BuildLALRAutomaton(*info_, lalr_options);
+    timings_.parser_automaton_ms = ElapsedMs(parser_start);
 
-  for (int id = 0; id < dfa_state_num_; ++id) {
-    const auto* const state = dfa->LookupState(id);
+    const auto table_start = std::chrono::steady_clock::now();
+    InitializeParsingTable(*pda);
+    timings_.parsing_table_ms = ElapsedMs(table_start);
+  };
 
-    acc_token_lookup_[id] = state->acc_token;
-    for (const auto edge : state->transitions) {
-      lexing_table_[id * 128 + edge.first] = edge.second->id;
-    }
+  // a generated scanner leaves nothing to overlap
+  if (!options.concurrent_construction || options.scanner != nullptr) {
+    build_lexer();
+    build_parser();
+  } else if (options.thread_pool != nullptr) {
+    // the calling thread takes one of them, so this cannot wait on a pool
+    // that is busy running the caller
+    options.thread_pool->ParallelFor(
+        2, [&](int i) { i == 0 ? build_lexer() : build_parser(); });
+  } else {
+    // the future joins the thread even if build_parser throws
+    auto lexer = std::async(std::launch::async, build_lexer);
+    build_parser();
+    lexer.get();
   }
 
+  timings_.total_ms = ElapsedMs(start);
+}
+
+auto CompiledGrammar::InitializeParsingTable(const ParserAutomaton& pda)
+    -> void {
+  pda_state_num_ = pda.StateCount();
+
+  // explicit errors from %nonassoc must not be replaced by a default
+  constexpr auto kMissingAction = std::numeric_limits<PackedAction>::min();
+
+  HeapArray<PackedAction> actions{pda_state_num_ * term_num_, kMissingAction};
+  HeapArray<int32_t> gotos{nonterm_num_ * pda_state_num_, -1};
+  eof_action_table_.initialize(pda_state_num_, kPackedActionError);
+
   for (int src_state_id = 0; src_state_id < pda_state_num_; ++src_state_id) {
-    const auto* state = pda->LookupState(src_state_id);
+    const auto* state = pda.LookupState(src_state_id);
 
     if (state->EofAction()) {
-      eof_action_table_[src_state_id] = TranslateAction(*state->EofAction());
+      eof_action_table_[src_state_id] =
+          TranslateAction(*info_, *state->EofAction());
     }
 
     for (const auto& pair : state->ActionMap()) {
       const auto tok_id = pair.first->Id();
 
-      action_table_[src_state_id * term_num_ + tok_id] =
-          TranslateAction(pair.second);
+      actions[src_state_id * term_num_ + tok_id] =
+          TranslateAction(*info_, pair.second);
     }
 
     for (const auto& pair : state->GotoMap()) {
       const auto var_id = pair.first->Id();
 
-      goto_table_[src_state_id * nonterm_num_ + var_id] = pair.second->Id();
+      gotos[var_id * pda_state_num_ + src_state_id] = pair.second->Id();
+    }
+  }
+
+  // the most frequent reduction of a state replaces its missing entries too,
+  // an error is then detected by a later lookup before anything is shifted
+  HeapArray<PackedAction> default_actions{pda_state_num_};
+  for (int id = 0; id < pda_state_num_; ++id) {
+    auto row = actions.ref().slice(id * term_num_, term_num_);
+    auto action = ChooseDefaultEntry(row, kMissingAction, kPackedActionError);
+
+    default_actions[id] = IsReduceAction(action) ? action : kPackedActionError;
+
+    for (int tok_id = 0; tok_id < term_num_; ++tok_id) {
+      auto& entry = actions[id * term_num_ + tok_id];
+      if (entry == kMissingAction) {
+        entry = default_actions[id];
+      }
+    }
+  }
+
+  // gotos are only looked up where defined, so missing ones are don't-cares
+  HeapArray<int32_t> default_gotos{nonterm_num_};
+  for (int id = 0; id < nonterm_num_; ++id) {
+    auto row = gotos.ref().slice(id * pda_state_num_, pda_state_num_);
+    default_gotos[id] = ChooseDefaultEntry(row, -1, -1);
+
+    for (int state = 0; state < pda_state_num_; ++state) {
+      auto& target = gotos[id * pda_state_num_ + state];
+      if (target == -1) {
+        target = default_gotos[id];
+      }
+    }
+  }
+
+  action_table_ = RowDisplacementTable::Compress(actions.ref(), term_num_,
+                                                 default_actions.ref());
+  goto_table_ = RowDisplacementTable::Compress(gotos.ref(), pda_state_num_,
+                                               default_gotos.ref());
+
+  InitializeProductionTable();
+  InitializeDefaultReductions();
+}
+
+auto CompiledGrammar::InitializeProductionTable() -> void {
+  const auto& productions = info_->Productions();
+  const int production_num = productions.size();
+
+  root_variable_id_ = info_->RootVariable().Id();
+  production_rhs_length_.initialize(production_num);
+  production_lhs_id_.initialize(production_num);
+  production_handle_.initialize(production_num);
+
+  for (int id = 0; id < production_num; ++id) {
+    production_rhs_length_[id] = productions[id].Right().size();
+    production_lhs_id_[id] = productions[id].Left()->Id();
+    production_handle_[id] = productions[id].Handle().get();
+  }
+}
+
+auto CompiledGrammar::InitializeDefaultReductions() -> void {
+  default_reduction_table_.initialize(pda_state_num_, kPackedActionError);
+
+  for (int state = 0; state < pda_state_num_; ++state) {
+    auto action = LookupParserAction(state, 0);
+    if (!IsReduceAction(action) ||
+        production_lhs_id_[ReduceProduction(action)] == root_variable_id_) {
+      // reducing to the root variable is how input gets accepted, which
+      // depends on the lookahead being eof
+      continue;
+    }
+
+    // error entries are fine, the error surfaces after the reduction
+    auto eof_action = LookupParserActionOnEof(state);
+    auto consistent = eof_action == action || eof_action == kPackedActionError;
+    for (int term_id = 1; term_id < term_num_ && consistent; ++term_id) {
+      consistent = LookupParserAction(state, term_id) == action;
+    }
+
+    if (consistent) {
+      default_reduction_table_[state] = action;
+    }
+  }
+}
+
+auto CompiledGrammar::InitializeLexer(const ParserOptions& options) -> void {
+  const auto start = std::chrono::steady_clock::now();
+
+  position_automaton_ = BuildPositionAutomaton(*info_);
+
+  char_classes_ = position_automaton_->char_classes;
+  char_class_num_ = char_classes_.ClassCount();
+
+  switch (options.lexer_mode) {
+    case LexerMode::Eager:
+      if (auto dfa = BuildLexerAutomaton(*position_automaton_,
+                                         options.dfa_state_limit,
+                                         options.thread_pool);
+          dfa) {
+        const auto table_start = std::chrono::steady_clock::now();
+        InitializeLexingTable(*dfa);
+        timings_.lexing_table_ms = ElapsedMs(table_start);
+      } else {
+        InitializeNfaLexer();
+      }
+      break;
+    case LexerMode::Lazy:
+      InitializeLazyLexer(options.lazy_cache_capacity);
+      break;
+    case LexerMode::Nfa:
+      InitializeNfaLexer();
+      break;
+    case LexerMode::Direct:
+      throw ParserConstructionError{
+          "CompiledGrammar: direct lexer mode requires a scanner"};
+  }
+
+  timings_.lexer_automaton_ms = ElapsedMs(start) - timings_.lexing_table_ms;
+}
+
+auto CompiledGrammar::InitializeLexingTable(const LexerAutomaton& dfa) -> void {
+  lexer_mode_ = LexerMode::Eager;
+  dfa_state_num_ = dfa.StateCount();
+
+  acc_token_lookup_.initialize(dfa_state_num_, nullptr);
+  lexing_table_.initialize(char_class_num_ * dfa_state_num_, -1);
+
+  for (int id = 0; id < dfa_state_num_; ++id) {
+    const auto* const state = dfa.LookupState(id);
+
+    acc_token_lookup_[id] = state->acc_token;
+    for (const auto& edge : state->transitions) {
+      for (int ch = edge.range.Min(); ch <= edge.range.Max(); ++ch) {
+        auto char_class = char_classes_.Lookup(ch);
+        lexing_table_[id * char_class_num_ + char_class] = edge.target->id;
+      }
     }
   }
+
+  InitializeSentinel();
+
+  // the position automaton is no longer needed
+  position_automaton_ = nullptr;
+}
+
+auto CompiledGrammar::InitializeSentinel() -> void {
+  const auto nul_class = char_classes_.Lookup('\0');
+
+  nul_ends_match_ = dfa_state_num_ > 0;
+  for (int id = 0; id < dfa_state_num_ && nul_ends_match_; ++id) {
+    nul_ends_match_ = lexing_table_[id * char_class_num_ + nul_class] == -1;
+  }
 }
 
-auto GenericParser::Parse(Arena& arena, const std::string& data)
+auto CompiledGrammar::InitializeLazyLexer(int cache_capacity) -> void {
+  // the initial state and a target state must fit in the cache together
+  if (cache_capacity < 2) {
+    throw ParserConstructionError{
+        "CompiledGrammar: lazy cache capacity must be at least 2"};
+  }
+
+  // every lexer context caches states of its own
+  lexer_mode_ = LexerMode::Lazy;
+  lazy_cache_capacity_ = cache_capacity;
+}
+
+auto CompiledGrammar::InitializeNfaLexer() -> void {
+  lexer_mode_ = LexerMode::Nfa;
+  nfa_ = std::make_unique<BitParallelNfa>(position_automaton_.get());
+}
+
+auto CompiledGrammar::Parse(Arena& arena, std::string_view data) const
     -> AST::ASTItem {
+  LexerContext lexer;
+  return Parse(lexer, arena, data);
+}
+
+auto CompiledGrammar::Parse(LexerContext& lexer, Arena& arena,
+                            std::string_view data) const -> AST::ASTItem {
+  PrepareLexerContext(lexer);
+  if (pipeline_threshold_ > 0 && data.length() >= pipeline_threshold_) {
+    return ParsePipelined(lexer, arena, data);
+  }
+
   ParserContext ctx{arena};
   int offset = 0;
 
+  ApplyDefaultReductions(ctx);
+
   // tokenize and feed parser while not exhausted
   while (offset < data.length()) {
-    auto tok = LoadToken(data, offset);
+    auto tok = LoadToken(lexer, data, offset);
 
     // update offset
     offset = tok.Offset() + tok.Length();
 
     // throw for invalid token
     if (!tok.IsValid()) {
-      throw ParserInternalError{"GenericParser: invalid token encountered"};
+      throw ParserInternalError{"CompiledGrammar: invalid token encountered"};
     }
     // ignore tokens in blacklist
     if (tok.Tag() >= term_num_) {
@@ -341,18 +719,43 @@ auto GenericParser::Parse(Arena& arena, const std::string& data)
   return ctx.Finalize();
 }
 
-auto GenericParser::LoadToken(std::string_view data, int offset)
+auto CompiledGrammar::Parse(Arena& arena, const TokenBuffer& tokens) const
+    -> AST::ASTItem {
+  ParserContext ctx{arena};
+  ApplyDefaultReductions(ctx);
+
+  for (int i = 0; i < tokens.Size(); ++i) {
+    // an invalid token would read as the end of input
+    const auto tag = tokens.Tags()[i];
+    if (tag < 0 || tag >= token_num_) {
+      throw ParserInternalError{"CompiledGrammar: invalid token encountered"};
+    }
+    if (tag >= term_num_) {
+      continue;
+    }
+
+    FeedParserContext(ctx, tokens[i]);
+  }
+
+  FeedParserContext(ctx, {});
+
+  return ctx.Finalize();
+}
+
+// longest match from offset, step consumes a char and sets the accepted
+// token, it returns false if no token can be matched any longer
+template <typename FStep>
+auto MatchLongestToken(std::string_view data, int offset, FStep step)
     -> AST::BasicASTToken {
   auto last_acc_len = 0;
   const TokenInfo* last_acc_token = nullptr;
 
-  auto state = LexerInitialState();
   for (int i = offset; i < data.length(); ++i) {
-    state = LookupLexingTransition(state, data[i]);
+    const TokenInfo* acc_token = nullptr;
 
-    if (!VerifyLexingState(state)) {
+    if (!step(data[i], acc_token)) {
       break;
-    } else if (const auto* acc_token = LookupAcceptedToken(state); acc_token) {
+    } else if (acc_token) {
       last_acc_len = i - offset + 1;
       last_acc_token = acc_token;
     }
@@ -365,54 +768,361 @@ auto GenericParser::LoadToken(std::string_view data, int offset)
   }
 }
 
-auto GenericParser::ForwardParserAction(ParserContext& ctx, ActionShift action,
-                                        const AST::BasicASTToken& tok)
-    -> ActionExecutionResult {
-  assert(tok.IsValid());
+auto BatchParseResult::FailureCount() const -> int {
+  return std::count_if(outcomes_.begin(), outcomes_.end(),
+                       [](const auto& item) { return !item.Succeeded(); });
+}
 
-  ctx.ExecuteShift(action.target_state, tok);
-  return ActionExecutionResult::Consumed;
+auto CompiledGrammar::ParseBatch(ArrayRef<std::string_view> inputs,
+                                 ThreadPool* pool) const -> BatchParseResult {
+  return ParseBatchImpl(inputs, pool);
 }
 
-auto GenericParser::ForwardParserAction(ParserContext& ctx, ActionReduce action,
-                                        const AST::BasicASTToken& tok)
-    -> ActionExecutionResult {
-  auto folded = ctx.ExecuteReduce(*action.production);
+auto CompiledGrammar::ParseBatch(ArrayRef<std::string> inputs,
+                                 ThreadPool* pool) const -> BatchParseResult {
+  return ParseBatchImpl(inputs, pool);
+}
 
-  auto nonterm_id = action.production->Left()->Id();
-  auto src_state = ctx.CurrentState();
-  auto target_state = LookupParsingGoto(src_state, nonterm_id);
+template <typename T>
+auto CompiledGrammar::ParseBatchImpl(ArrayRef<T> inputs, ThreadPool* pool) const
+    -> BatchParseResult {
+  const int input_num = inputs.size();
+  const int worker_num =
+      std::min(input_num, pool != nullptr ? pool->ThreadCount() + 1 : 1);
+
+  BatchParseResult result;
+  result.outcomes_.resize(input_num);
+  for (int i = 0; i < worker_num; ++i) {
+    result.arenas_.push_back(Arena::Create());
+  }
 
-  ctx.ExecuteShift(target_state, folded);
+  // workers take the next input when done with one, so a worker stuck on a
+  // long input does not hold up short ones queued behind it
+  std::atomic<int> next = 0;
+  ParallelFor(pool, worker_num, [&](int worker) {
+    auto& arena = *result.arenas_[worker];
+    LexerContext lexer;
+
+    for (int i; (i = next++) < input_num;) {
+      auto& outcome = result.outcomes_[i];
+      try {
+        outcome.value = Parse(lexer, arena, inputs[i]);
+      } catch (...) {
+        outcome.error = std::current_exception();
+      }
+    }
+  });
+
+  return result;
+}
+
+namespace {
+
+// tokens travel from the lexer thread to the parser thread in batches, so
+// that the two sides only synchronize once per batch
+constexpr int kTokenBatchSize = 256;
+constexpr int kTokenRingCapacity = 64;
+
+struct TokenBatch {
+  int size;
+  Array<AST::BasicASTToken, kTokenBatchSize> tokens;
+
+  // no token follows this batch, because the input is exhausted or because
+  // no token matches at the end of the batch
+  bool last;
+  bool invalid;
+};
+
+// a side that finds the ring full or empty yields this many times before it
+// blocks, so a short stall of the other side costs no wakeup and a long one
+// does not keep a core busy
+constexpr int kPipelineSpinCount = 64;
+
+// where the two sides of the pipeline wait for each other, each notifies
+// after every change to the ring or to the flags the other side waits on
+struct PipelineSignal {
+  std::mutex mutex;
+  std::condition_variable changed;
+
+  auto Notify() -> void {
+    // a waiter checks its condition under the mutex before it blocks
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+    }
+    changed.notify_one();
+  }
+
+  template <typename FReady>
+  auto Await(FReady ready) -> void {
+    for (int i = 0; i < kPipelineSpinCount; ++i) {
+      if (ready()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock{mutex};
+    BlockUntil(changed, lock, ready);
+  }
+};
+
+}  // namespace
+
+auto CompiledGrammar::ParsePipelined(LexerContext& lexer, Arena& arena,
+                                     std::string_view data) const
+    -> AST::ASTItem {
+  SpscRing<TokenBatch> ring{kTokenRingCapacity};
+
+  // set by the parser to stop the lexer early, and by the lexer if it threw
+  std::atomic<bool> cancelled = false;
+  std::atomic<bool> lexer_failed = false;
+  std::exception_ptr lexer_error;
+  PipelineSignal signal;
+
+  // the lexer has the lexer context to itself until it is joined
+  std::thread lexer_thread{[&] {
+    try {
+      for (int offset = 0;;) {
+        TokenBatch* batch = nullptr;
+        signal.Await([&] {
+          return cancelled || (batch = ring.Back()) != nullptr;
+        });
+        if (cancelled) {
+          break;
+        }
+
+        batch->size = 0;
+        batch->invalid = false;
+        while (batch->size < kTokenBatchSize && offset < data.length()) {
+          auto tok = LoadToken(lexer, data, offset);
+          if (!tok.IsValid()) {
+            batch->invalid = true;
+            break;
+          }
+
+          // ignored tokens are dropped right away
+          offset = tok.Offset() + tok.Length();
+          if (tok.Tag() < term_num_) {
+            batch->tokens[batch->size++] = tok;
+          }
+        }
+
+        const auto last = batch->invalid || offset >= data.length();
+        batch->last = last;
+        ring.Push();
+        signal.Notify();
+
+        if (last) {
+          break;
+        }
+      }
+    } catch (...) {
+      lexer_error = std::current_exception();
+      lexer_failed = true;
+      signal.Notify();
+    }
+  }};
+
+  ParserContext ctx{arena};
+  try {
+    ApplyDefaultReductions(ctx);
+
+    // errors surface in input order, as they would without the pipeline
+    for (auto last = false; !last;) {
+      TokenBatch* batch = nullptr;
+      signal.Await([&] {
+        return (batch = ring.Front()) != nullptr || lexer_failed;
+      });
+
+      // the flag may be raised right after the last batch was pushed
+      if (batch == nullptr && (batch = ring.Front()) == nullptr) {
+        std::rethrow_exception(lexer_error);
+      }
 
-  if (!tok.IsValid() && ctx.StackDepth() == 1 &&
-      action.production->Left() == &info_->RootVariable()) {
-    return ActionExecutionResult::Consumed;
+      for (int i = 0; i < batch->size; ++i) {
+        FeedParserContext(ctx, batch->tokens[i]);
+      }
+
+      last = batch->last;
+      const auto invalid = batch->invalid;
+      ring.Pop();
+      signal.Notify();
+
+      if (invalid) {
+        throw ParserInternalError{
+            "CompiledGrammar: invalid token encountered"};
+      }
+    }
+
+    FeedParserContext(ctx, {});
+  } catch (...) {
+    cancelled = true;
+    signal.Notify();
+    lexer_thread.join();
+    throw;
+  }
+
+  lexer_thread.join();
+  return ctx.Finalize();
+}
+
+auto CompiledGrammar::PrepareLexerContext(LexerContext& lexer) const -> void {
+  if (lexer.owner_ == this) {
+    return;
+  }
+
+  lexer.owner_ = this;
+  lexer.lazy_dfa_ = nullptr;
+  if (lexer_mode_ == LexerMode::Lazy) {
+    lexer.lazy_dfa_ = std::make_unique<LazyDfa>(position_automaton_.get(),
+                                                lazy_cache_capacity_);
+  } else if (lexer_mode_ == LexerMode::Nfa) {
+    lexer.nfa_state_ = Bitset{nfa_->PositionCount()};
+    lexer.nfa_next_state_ = Bitset{nfa_->PositionCount()};
+  }
+}
+
+auto CompiledGrammar::LoadToken(LexerContext& lexer, std::string_view data,
+                                int offset) const -> AST::BasicASTToken {
+  switch (lexer_mode_) {
+    case LexerMode::Direct:
+      return scanner_(data, offset);
+    case LexerMode::Eager: {
+      auto state = LexerInitialState();
+      return MatchLongestToken(
+          data, offset, [&](char ch, const TokenInfo*& acc_token) {
+            state = LookupLexingTransition(state, ch);
+            if (!VerifyLexingState(state)) {
+              return false;
+            }
+
+            acc_token = LookupAcceptedToken(state);
+            return true;
+          });
+    }
+    case LexerMode::Lazy: {
+      auto& dfa = *lexer.lazy_dfa_;
+      auto state = dfa.InitialState();
+      return MatchLongestToken(
+          data, offset, [&](char ch, const TokenInfo*& acc_token) {
+            state = dfa.Transit(state, ch);
+            if (state == LazyDfa::kDeadState) {
+              return false;
+            }
+
+            acc_token = dfa.AcceptedToken(state);
+            return true;
+          });
+    }
+    case LexerMode::Nfa: {
+      auto& state = lexer.nfa_state_;
+      auto& next_state = lexer.nfa_next_state_;
+
+      state = nfa_->InitialState();
+      return MatchLongestToken(
+          data, offset, [&](char ch, const TokenInfo*& acc_token) {
+            nfa_->Transit(state, ch, next_state);
+            std::swap(state, next_state);
+            if (state.none()) {
+              return false;
+            }
+
+            acc_token = nfa_->AcceptedToken(state);
+            return true;
+          });
+    }
+  }
+
+  assert(false && "unknown lexer mode");
+  return AST::BasicASTToken{};
+}
+
+auto CompiledGrammar::LoadTerminatedToken(LexerContext& lexer,
+                                          const std::string& data,
+                                          int offset) const
+    -> AST::BasicASTToken {
+  if (lexer_mode_ != LexerMode::Eager || !nul_ends_match_) {
+    return LoadToken(lexer, data, offset);
+  }
+
+  // the nul byte after data is a dead end from every state, so the loop only
+  // stops on a dead state
+  const char* const begin = data.c_str() + offset;
+  auto last_acc_len = 0;
+  const TokenInfo* last_acc_token = nullptr;
+
+  auto state = LexerInitialState();
+  for (const char* p = begin;; ++p) {
+    state = LookupLexingTransition(state, *p);
+    if (!VerifyLexingState(state)) {
+      break;
+    }
+
+    if (const auto* acc_token = LookupAcceptedToken(state)) {
+      last_acc_len = p - begin + 1;
+      last_acc_token = acc_token;
+    }
+  }
+
+  if (last_acc_len != 0) {
+    return AST::BasicASTToken{offset, last_acc_len, last_acc_token->Id()};
   } else {
-    return ActionExecutionResult::Hungry;
+    return AST::BasicASTToken{};
   }
 }
-auto GenericParser::ForwardParserAction(ParserContext& /*ctx*/,
-                                        ActionError /*action*/,
-                                        const AST::BasicASTToken& /*tok*/)
-    -> ActionExecutionResult {
-  return ActionExecutionResult::Error;
+
+auto CompiledGrammar::ApplyReduction(ParserContext& ctx, int production) const
+    -> void {
+  auto nonterm_id = production_lhs_id_[production];
+  auto folded = ctx.ExecuteReduce(production_rhs_length_[production],
+                                  *production_handle_[production]);
+
+  auto target_state = LookupParsingGoto(ctx.CurrentState(), nonterm_id);
+  ctx.ExecuteShift(target_state, folded);
 }
 
-auto GenericParser::FeedParserContext(ParserContext& ctx,
-                                      const AST::BasicASTToken& tok) -> void {
+// reduces right after a shift or goto where the lookahead cannot matter, so
+// the next token is not needed yet
+auto CompiledGrammar::ApplyDefaultReductions(ParserContext& ctx) const
+    -> void {
+  while (true) {
+    auto action = default_reduction_table_[ctx.CurrentState()];
+    if (!IsReduceAction(action)) {
+      break;
+    }
+
+    ApplyReduction(ctx, ReduceProduction(action));
+  }
+}
+
+auto CompiledGrammar::FeedParserContext(ParserContext& ctx,
+                                        const AST::BasicASTToken& tok) const
+    -> void {
+  const auto eof = !tok.IsValid();
+
+  // after a goto, a default reduction is found by the lookup below, as it is
+  // the default of its row in the action table
   while (true) {
     auto cur_state = ctx.CurrentState();
-    auto action = tok.IsValid() ? LookupParserAction(cur_state, tok.Tag())
-                                : LookupParserActionOnEof(cur_state);
+    auto action = eof ? LookupParserActionOnEof(cur_state)
+                      : LookupParserAction(cur_state, tok.Tag());
 
-    auto action_result =
-        visit([&](auto x) { return ForwardParserAction(ctx, x, tok); }, action);
+    if (IsShiftAction(action)) {
+      assert(!eof);
 
-    if (action_result == ActionExecutionResult::Error) {
-      throw ParserInternalError{"parsing error"};
-    } else if (action_result == ActionExecutionResult::Consumed) {
+      ctx.ExecuteShift(ShiftTarget(action), tok);
+      ApplyDefaultReductions(ctx);
       break;
+    } else if (IsReduceAction(action)) {
+      auto production = ReduceProduction(action);
+      ApplyReduction(ctx, production);
+
+      if (eof && ctx.StackDepth() == 1 &&
+          production_lhs_id_[production] == root_variable_id_) {
+        break;
+      }
+    } else {
+      throw ParserInternalError{"parsing error"};
     }
   }
 }
@@ -1,12 +1,19 @@
 #include "RegGen/Parser/ParserAutomaton.h"
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
+#include <limits>
 #include <map>
 #include <set>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "RegGen/Common/Error.h"
+#include "RegGen/Common/Format.h"
+#include "RegGen/Common/ThreadPool.h"
+#include "RegGen/Container/Bitset.h"
 #include "RegGen/Container/FlatSet.h"
 #include "RegGen/Container/SmallVector.h"
 #include "RegGen/Parser/Grammar.h"
@@ -28,7 +35,8 @@ auto ParserState::RegisterShift(const ParserState* dest, const SymbolInfo* s)
 
 auto ParserState::RegisterReduce(const ProductionInfo* p, const TokenInfo* tok)
     -> void {
-  assert(action_map_.count(tok) == 0);
+  assert(action_map_.count(tok) == 0 ||
+         std::holds_alternative<PdaEdgeShift>(action_map_.at(tok)));
   action_map_.insert_or_assign(tok, PdaEdgeReduce{p});
 }
 
@@ -37,82 +45,201 @@ auto ParserState::RegisterReduceOnEof(const ProductionInfo* p) -> void {
   eof_action_ = PdaEdgeReduce{p};
 }
 
-auto ParserAutomaton::MakeState(const ItemSet& items) -> ParserState* {
-  auto iter = states_.find(items);
-  if (iter == states_.end()) {
-    auto id = static_cast<int>(states_.size());
-    iter = states_.try_emplace(iter, items, ParserState{id});
+auto ParserState::RegisterError(const TokenInfo* tok) -> void {
+  action_map_.insert_or_assign(tok, PdaEdgeError{});
+}
+
+auto ParserState::RedirectShift(const ParserState* dest, const SymbolInfo* s)
+    -> void {
+  if (const auto* tok = s->AsToken(); tok) {
+    assert(std::holds_alternative<PdaEdgeShift>(action_map_.at(tok)));
+    action_map_.insert_or_assign(tok, PdaEdgeShift{dest});
+  } else {
+    const auto* var = s->AsVariable();
 
-    ptrs_.push_back(&iter->second);
+    assert(goto_map_.count(var) != 0);
+    goto_map_.insert_or_assign(var, dest);
+  }
+}
+
+auto ParserAutomaton::HashKernel(const ItemSet& kernel) -> size_t {
+  size_t result = kernel.size();
+  for (const auto& item : kernel) {
+    result = (result ^ item.Hash()) * 1099511628211ULL;
   }
 
-  return &(iter->second);
+  return result;
 }
 
-auto ParserAutomaton::EnumerateState(
-    std::function<void(const ItemSet&, ParserState&)> callback) -> void {
-  for (auto& pair : states_) {
-    callback(pair.first, pair.second);
+auto ParserAutomaton::GrowSlots() -> void {
+  slots_.clear();
+  slots_.resize(std::max<size_t>(64, states_.size() * 4), -1);
+
+  const auto mask = slots_.size() - 1;
+  for (int id = 0; id < states_.size(); ++id) {
+    auto slot = states_[id].hash & mask;
+    while (slots_[slot] != -1) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = id;
   }
 }
 
-template <typename F>
-auto EnumerateClosureItems(const MetaInfo& /*info*/, const ItemSet& kernel,
-                           F callback) -> void {
-  static_assert(std::is_invocable_v<F, ParserItem>);
+auto ParserAutomaton::MakeState(ItemSet kernel)
+    -> std::pair<ParserState*, bool> {
+  // keep the load factor under 1/2
+  if (2 * (states_.size() + 1) > slots_.size()) {
+    GrowSlots();
+  }
 
-  auto added = std::unordered_set<const VariableInfo*>{};
-  auto to_be_visited = SmallVector<const VariableInfo*>{};
+  const auto hash = HashKernel(kernel);
+  const auto mask = slots_.size() - 1;
 
-  const auto try_register_candidate = [&](const SymbolInfo* s) {
-    if (const auto* candidate = s->AsVariable(); candidate) {
-      if (added.count(candidate) == 0) {
-        added.insert(candidate);
-        to_be_visited.push_back(candidate);
-      }
+  // linear probing
+  auto slot = hash & mask;
+  for (; slots_[slot] != -1; slot = (slot + 1) & mask) {
+    auto& entry = states_[slots_[slot]];
+    if (entry.hash == hash && entry.kernel == kernel) {
+      return {&entry.state, false};
     }
+  }
+
+  auto id = static_cast<int>(states_.size());
+  slots_[slot] = id;
+  states_.push_back(StateEntry{std::move(kernel), hash, ParserState{id}});
+
+  return {&states_.back().state, true};
+}
+
+auto ParserAutomaton::EnumerateState(
+    std::function<void(const ItemSet&, ParserState&)> callback) -> void {
+  for (auto& entry : states_) {
+    callback(entry.kernel, entry.state);
+  }
+}
+
+// F(x) = F'(x) united with F(y) for every y reachable from x in relation,
+// sets passed in hold F' and are replaced by F
+//
+// this is the digraph traversal of DeRemer and Pennello, a strongly connected
+// component ends up with one shared set, recursion is replaced by a stack of
+// frames so that long chains cannot overflow the call stack
+auto SolveDigraph(const SmallVector<SmallVector<int>>& relation,
+                  SmallVector<Bitset>& sets) -> void {
+  constexpr auto kFinished = std::numeric_limits<int>::max();
+
+  struct Frame {
+    int node;
+    int depth;
+    int next_edge;
   };
 
-  // visit kernel items and record nonterms for closure calculation
-  for (const auto& item : kernel) {
-    callback(item);
+  const int node_num = relation.size();
+  SmallVector<int> depth(node_num, 0);
+  SmallVector<int> stack;
+  SmallVector<Frame> frames;
+
+  const auto enter = [&](int x) {
+    stack.push_back(x);
+    depth[x] = stack.size();
+    frames.push_back(Frame{x, depth[x], 0});
+  };
 
-    // Item{ A -> \alpha . }: skip it
-    // Item{ A -> \alpha . B \gamma }: queue unvisited nonterm B for further
-    // expansion
-    if (const auto* s = item.NextSymbol(); s) {
-      try_register_candidate(s);
+  for (int root = 0; root < node_num; ++root) {
+    if (depth[root] != 0) {
+      continue;
     }
-  }
 
-  // genreate and visit non-kernel items recursively
-  while (!to_be_visited.empty()) {
-    const auto* variable = to_be_visited.back();
-    to_be_visited.pop_back();
+    enter(root);
+    while (!frames.empty()) {
+      auto frame = frames.back();
+      const auto x = frame.node;
+
+      if (frame.next_edge < relation[x].size()) {
+        const auto y = relation[x][frame.next_edge];
+        if (depth[y] == 0) {
+          // the edge is revisited once y is done
+          enter(y);
+          continue;
+        }
+
+        depth[x] = std::min(depth[x], depth[y]);
+        sets[x] |= sets[y];
+        frames.back().next_edge += 1;
+        continue;
+      }
+
+      frames.pop_back();
+      if (depth[x] == frame.depth) {
+        while (true) {
+          auto top = stack.back();
+          stack.pop_back();
 
-    for (const auto& p : variable->Productions()) {
-      callback(ParserItem{p, 0});
+          depth[top] = kFinished;
+          if (top == x) {
+            break;
+          }
 
-      if (!p->Right().empty()) {
-        try_register_candidate(p->Right().front());
+          sets[top] = sets[x];
+        }
       }
     }
   }
 }
 
-auto ComputeGotoItems(const MetaInfo& info, const ItemSet& src,
-                      const SymbolInfo* s) -> ItemSet {
-  ItemSet new_state;
+// closure of item sets, the non-kernel items contributed by a nonterminal B
+// are C -> . \gamma for every C reachable from B by leftmost derivation,
+// which only depends on B and so is computed once per variable
+class ClosureTable {
+ public:
+  explicit ClosureTable(const MetaInfo& info) : info_(info) {
+    const int var_num = info.Variables().size();
+
+    // B reaches C if some production B -> C \gamma
+    SmallVector<SmallVector<int>> starts_with(var_num);
+    for (const auto& production : info.Productions()) {
+      if (production.Right().empty()) {
+        continue;
+      }
+      if (const auto* var = production.Right().front()->AsVariable(); var) {
+        starts_with[production.Left()->Id()].push_back(var->Id());
+      }
+    }
 
-  EnumerateClosureItems(info, src, [&](ParserItem item) {
-    // for Item A -> \alpha . B \beta where B == s, advance the cursor
-    if (item.NextSymbol() == s) {
-      new_state.insert(item.CreateSuccessor());
+    reachable_.resize(var_num, Bitset{var_num});
+    for (int id = 0; id < var_num; ++id) {
+      reachable_[id].set(id);
     }
-  });
+    SolveDigraph(starts_with, reachable_);
+  }
 
-  return new_state;
-}
+  // invoke callback with kernel items, then each non-kernel item once
+  template <typename F>
+  auto Enumerate(const ItemSet& kernel, F callback) const -> void {
+    static_assert(std::is_invocable_v<F, ParserItem>);
+
+    Bitset expanded{static_cast<int>(reachable_.size())};
+    for (const auto& item : kernel) {
+      callback(item);
+
+      if (const auto* s = item.NextSymbol(); s && s->IsVariable()) {
+        expanded |= reachable_[s->AsVariable()->Id()];
+      }
+    }
+
+    expanded.for_each([&](int id) {
+      for (const auto* p : info_.Variables()[id].Productions()) {
+        callback(ParserItem{p, 0});
+      }
+    });
+  }
+
+ private:
+  const MetaInfo& info_;
+
+  // variables whose productions are in the closure of B, indexed by id
+  SmallVector<Bitset> reachable_;
+};
 
 auto GenerateInitialItems(const MetaInfo& info) -> ItemSet {
   ItemSet result;
@@ -123,47 +250,99 @@ auto GenerateInitialItems(const MetaInfo& info) -> ItemSet {
   return result;
 }
 
-template <typename F>
-void EnumerateSymbols(const MetaInfo& info, F callback) {
-  static_assert(std::is_invocable_v<F, const SymbolInfo*>);
+// kernels reached from a state, by ascending symbol index
+struct StateTransitions {
+  SmallVector<int> symbols;
+  SmallVector<ItemSet> kernels;
+};
 
-  for (const auto& tok : info.Tokens()) {
-    callback(&tok);
-  }
+auto BootstrapParsingAutomaton(const MetaInfo& info,
+                               const ClosureTable& closure, ThreadPool* pool) {
+  // number of states expanded by one task
+  constexpr int kChunkSize = 16;
 
-  for (const auto& var : info.Variables()) {
-    callback(&var);
-  }
-}
-
-auto BootstrapParsingAutomaton(const MetaInfo& info) {
   auto pda = std::make_unique<ParserAutomaton>();
 
-  auto initial_set = GenerateInitialItems(info);
+  // the initial kernel is the only one with items of cursor 0
+  pda->MakeState(GenerateInitialItems(info));
 
-  for (std::deque<ItemSet> unprocessed{initial_set}; !unprocessed.empty();
-       unprocessed.pop_front()) {
-    const auto& src_items = unprocessed.front();
-    auto* const src_state = pda->MakeState(src_items);
+  // symbols are indexed tokens first, then variables, targets are created in
+  // this order so that state ids only depend on the grammar
+  const int token_num = info.Tokens().size();
+  const auto symbol_index = [&](const SymbolInfo* s) {
+    return s->IsToken() ? s->Id() : token_num + s->Id();
+  };
+  const auto index_symbol = [&](int index) -> const SymbolInfo* {
+    if (index < token_num) {
+      return &info.Tokens()[index];
+    }
+    return &info.Variables()[index - token_num];
+  };
 
-    EnumerateSymbols(info, [&](const SymbolInfo* s) {
-      // calculate the target state for symbol s
-      auto dest_items = ComputeGotoItems(info, src_items, s);
+  // kernels of the targets of a state are gathered by symbol index, the
+  // buckets are reused across the states of a chunk
+  const int symbol_num = token_num + info.Variables().size();
+  using ItemBucket = SmallVector<ParserItem>;
+  const auto compute_transitions = [&](const ItemSet& kernel,
+                                       SmallVector<ItemBucket>& targets,
+                                       StateTransitions& result) {
+    // for Item A -> \alpha . X \beta, advance the cursor into the target of X
+    // NOTE closure enumerates each item once, so buckets have no duplicates
+    closure.Enumerate(kernel, [&](ParserItem item) {
+      if (const auto* s = item.NextSymbol(); s) {
+        auto index = symbol_index(s);
+        if (targets[index].empty()) {
+          result.symbols.push_back(index);
+        }
 
-      // empty set of item is not a valid state
-      if (dest_items.empty()) {
-        return;
+        targets[index].push_back(item.CreateSuccessor());
       }
+    });
 
-      // compute target state
-      auto old_state_cnt = pda->States().size();
-      ParserState* dest_state = pda->MakeState(dest_items);
-      if (pda->States().size() > old_state_cnt) {
-        unprocessed.push_back(dest_items);
-      }
+    // sort each kernel once instead of inserting item by item
+    std::sort(result.symbols.begin(), result.symbols.end());
+    for (auto index : result.symbols) {
+      result.kernels.emplace_back(targets[index].begin(), targets[index].end());
+      targets[index].clear();
+    }
+  };
 
-      src_state->RegisterShift(dest_state, s);
+  // states are expanded a generation at a time. the transitions of a
+  // generation are computed in parallel, then their targets are interned in
+  // the order of source id and symbol, so that ids are assigned exactly as a
+  // sequential breadth-first traversal would
+  SmallVector<StateTransitions> generation;
+  for (int begin = 0; begin < pda->StateCount();) {
+    const auto end = pda->StateCount();
+
+    generation.clear();
+    generation.resize(end - begin);
+
+    const auto chunk_num = (end - begin + kChunkSize - 1) / kChunkSize;
+    ParallelFor(pool, chunk_num, [&](int chunk) {
+      SmallVector<ItemBucket> targets(symbol_num);
+
+      const auto chunk_begin = begin + chunk * kChunkSize;
+      const auto chunk_end = std::min(end, chunk_begin + kChunkSize);
+      for (int id = chunk_begin; id < chunk_end; ++id) {
+        compute_transitions(pda->LookupKernel(id), targets,
+                            generation[id - begin]);
+      }
     });
+
+    for (int i = 0; i < end - begin; ++i) {
+      auto& transitions = generation[i];
+      auto* src_state = pda->LookupState(begin + i);
+
+      for (int j = 0; j < transitions.symbols.size(); ++j) {
+        auto* dest_state = pda->MakeState(std::move(transitions.kernels[j]))
+                               .first;
+        src_state->RegisterShift(dest_state,
+                                 index_symbol(transitions.symbols[j]));
+      }
+    }
+
+    begin = end;
   }
 
   return pda;
@@ -178,8 +357,8 @@ auto LookupTargetState(const ParserState* src, const SymbolInfo* s)
   }
 }
 
-auto CreateExtendedGrammar(const MetaInfo& info, ParserAutomaton& pda)
-    -> std::unique_ptr<Grammar> {
+auto CreateExtendedGrammar(const MetaInfo& info, const ClosureTable& closure,
+                           ParserAutomaton& pda) -> std::unique_ptr<Grammar> {
   GrammarBuilder builder;
 
   // extend symbols
@@ -204,7 +383,7 @@ auto CreateExtendedGrammar(const MetaInfo& info, ParserAutomaton& pda)
   auto* new_root = builder.MakeNonterminal(&info.RootVariable(), nullptr);
 
   pda.EnumerateState([&](const ItemSet& items, ParserState& state) {
-    EnumerateClosureItems(info, items, [&](ParserItem item) {
+    closure.Enumerate(items, [&](ParserItem item) {
       if (item.IsKernel()) {
         return;
       }
@@ -250,56 +429,415 @@ auto CreateExtendedGrammar(const MetaInfo& info, ParserAutomaton& pda)
   return builder.Build(new_root);
 }
 
-auto BuildLALRAutomaton(const MetaInfo& info)
-    -> std::unique_ptr<const ParserAutomaton> {
-  auto pda = BootstrapParsingAutomaton(info);
-  auto ext_grammar = CreateExtendedGrammar(info, *pda);
+enum class ConflictResolution { Shift, Reduce, Error };
 
-  // (state where reduction is done, production)
-  using LocatedProduction =
-      std::tuple<const ParserState*, const ProductionInfo*>;
+// decides a shift/reduce conflict on tok like yacc does, by the precedence
+// of tok against that of production and then by associativity
+auto ResolveShiftReduce(const ProductionInfo& production, const TokenInfo& tok)
+    -> std::optional<ConflictResolution> {
+  const auto* production_tok = production.PrecedenceToken();
+  if (tok.Precedence() == 0 || production_tok == nullptr ||
+      production_tok->Precedence() == 0) {
+    return std::nullopt;
+  }
 
-  // merge follow set
-  std::set<LocatedProduction> merged_ending;
-  std::map<LocatedProduction, FlatSet<const TokenInfo*>> merged_follow;
+  if (production_tok->Precedence() != tok.Precedence()) {
+    return production_tok->Precedence() > tok.Precedence()
+               ? ConflictResolution::Reduce
+               : ConflictResolution::Shift;
+  }
+
+  switch (tok.Assoc()) {
+    case Associativity::Left:
+      return ConflictResolution::Reduce;
+    case Associativity::Right:
+      return ConflictResolution::Shift;
+    case Associativity::NonAssoc:
+      return ConflictResolution::Error;
+  }
+
+  return std::nullopt;
+}
+
+// production A -> B whose handle yields B unchanged
+auto IsPassThroughUnitProduction(const ProductionInfo& production) -> bool {
+  if (production.Right().size() != 1) {
+    return false;
+  }
+
+  const auto& handle = *production.Handle();
+  const auto* selector =
+      std::get_if<AST::ASTItemSelector>(&handle.Generator());
+
+  return selector != nullptr && selector->Index() == 0 &&
+         std::holds_alternative<AST::ASTManipPlaceholder>(
+             handle.Manipulator());
+}
+
+// the pass-through unit production that a state reduces regardless of the
+// lookahead, or nullptr
+auto LookupUnitReduction(const MetaInfo& info, const ParserState& state)
+    -> const ProductionInfo* {
+  if (!state.GotoMap().empty() ||
+      (state.ActionMap().empty() && !state.EofAction())) {
+    return nullptr;
+  }
+
+  const ProductionInfo* result = nullptr;
+  auto reduce_only = [&](const PdaEdge& edge) {
+    const auto* reduce = std::get_if<PdaEdgeReduce>(&edge);
+    if (reduce == nullptr ||
+        (result != nullptr && reduce->production != result)) {
+      return false;
+    }
+
+    result = reduce->production;
+    return true;
+  };
+
+  if (state.EofAction() && !reduce_only(*state.EofAction())) {
+    return nullptr;
+  }
+  for (const auto& pair : state.ActionMap()) {
+    if (!reduce_only(pair.second)) {
+      return nullptr;
+    }
+  }
+
+  // reducing to root accepts the input, which must not be skipped
+  if (result->Left() == &info.RootVariable() ||
+      !IsPassThroughUnitProduction(*result)) {
+    return nullptr;
+  }
+
+  return result;
+}
+
+// the stack is the same after shifting to a unit reduction state and then
+// reducing, as after shifting straight to the goto target of its lhs, since
+// the handle passes the item through
+//
+// errors are still caught before the next shift as the skipped reduction
+// would have been a default reduction anyway
+auto EliminateUnitProductions(const MetaInfo& info, ParserAutomaton& pda)
+    -> void {
+  pda.EnumerateState([&](const ItemSet& /*items*/, ParserState& state) {
+    auto bypass = [&](const ParserState* target) {
+      // a chain cannot be longer than the number of states
+      for (int i = 0; i < pda.StateCount(); ++i) {
+        const auto* production = LookupUnitReduction(info, *target);
+        if (production == nullptr) {
+          break;
+        }
+
+        target = state.GotoMap().at(production->Left());
+      }
+
+      return target;
+    };
+
+    SmallVector<std::pair<const SymbolInfo*, const ParserState*>> redirects;
+    for (const auto& [tok, edge] : state.ActionMap()) {
+      if (const auto* shift = std::get_if<PdaEdgeShift>(&edge); shift) {
+        if (const auto* target = bypass(shift->target);
+            target != shift->target) {
+          redirects.push_back({tok, target});
+        }
+      }
+    }
+    for (const auto& [var, dest] : state.GotoMap()) {
+      if (const auto* target = bypass(dest); target != dest) {
+        redirects.push_back({var, target});
+      }
+    }
+
+    for (const auto& [symbol, target] : redirects) {
+      state.RedirectShift(target, symbol);
+    }
+  });
+}
+
+// (state where reduction is done, production)
+using LocatedProduction = std::tuple<const ParserState*, const ProductionInfo*>;
+
+// lookaheads of every reduction, bit i is the token of id i and the bit past
+// the last token is eof
+using LookaheadMap = std::map<LocatedProduction, Bitset>;
+
+auto ComputeLookaheadsByExtendedGrammar(const MetaInfo& info,
+                                        const ClosureTable& closure,
+                                        ParserAutomaton& pda) -> LookaheadMap {
+  auto ext_grammar = CreateExtendedGrammar(info, closure, pda);
+  const int eof_id = info.Tokens().size();
+
+  // token id of each extended terminal
+  SmallVector<int> token_ids;
+  for (int id = 0; id < ext_grammar->Terminals().size(); ++id) {
+    token_ids.push_back(ext_grammar->LookupTerminal(id)->Info()->Id());
+  }
+
+  // merge follow set, epsilon productions are not supported here as their
+  // states are not recorded
+  LookaheadMap result;
   for (const auto& p : ext_grammar->Productions()) {
     const auto& lhs = p->Left();
     const auto& rhs = p->Right();
+    if (rhs.empty()) {
+      continue;
+    }
 
     auto key = LocatedProduction{rhs.back()->Version(), p->Info()};
+    auto& lookaheads =
+        result.try_emplace(key, Bitset{eof_id + 1}).first->second;
 
     // normalized ending
     if (lhs->MayPreceedEof()) {
-      merged_ending.insert(key);
+      lookaheads.set(eof_id);
     }
 
     // normalized FOLLOW set
-    auto& follow = merged_follow[key];
-    for (auto* term : lhs->FollowSet()) {
-      follow.insert(term->Info());
+    lhs->FollowSet().for_each([&](int id) { lookaheads.set(token_ids[id]); });
+  }
+
+  return result;
+}
+
+// variables that derive the empty string
+auto ComputeNullableVariables(const MetaInfo& info) -> Bitset {
+  Bitset result{static_cast<int>(info.Variables().size())};
+
+  for (auto growing = true; growing;) {
+    growing = false;
+
+    for (const auto& production : info.Productions()) {
+      const auto lhs_id = production.Left()->Id();
+      if (result.test(lhs_id)) {
+        continue;
+      }
+
+      const auto& rhs = production.Right();
+      auto nullable = std::all_of(rhs.begin(), rhs.end(), [&](auto* s) {
+        const auto* var = s->AsVariable();
+        return var != nullptr && result.test(var->Id());
+      });
+
+      if (nullable) {
+        result.set(lhs_id);
+        growing = true;
+      }
     }
   }
 
-  // register reductions
-  pda->EnumerateState([&](const ItemSet& items, ParserState& state) {
-    for (auto item : items) {
-      const auto& production = item.Production();
-      auto key = LocatedProduction{&state, production};
+  return result;
+}
 
-      if (item.IsFinalized()) {
-        // EOF
-        if (merged_ending.count(key) > 0) {
-          state.RegisterReduceOnEof(production);
+// lookaheads by DeRemer and Pennello, Efficient Computation of LALR(1)
+// Look-Ahead Sets, 1982, over nonterminal transitions (p, A) of the lr(0)
+// automaton:
+//
+//   DR(p, A)     tokens shifted right after goto(p, A)
+//   reads        (p, A) reads (r, C) if r = goto(p, A) and C is nullable
+//   includes     (p, A) includes (p', B) if B -> b A c, c is nullable and
+//                p' reaches p through b
+//   lookback     (q, B -> w) lookback (p', B) if p' reaches q through w
+//
+//   Read = DR closed over reads, Follow = Read closed over includes, and
+//   LA(q, B -> w) = union of Follow(p', B) over its lookbacks
+auto ComputeLookaheadsByRelations(const MetaInfo& info,
+                                  const ParserAutomaton& pda) -> LookaheadMap {
+  const int eof_id = info.Tokens().size();
+  const int state_num = pda.StateCount();
+  const int var_num = info.Variables().size();
+
+  const auto nullable = ComputeNullableVariables(info);
+  const auto* initial_state = pda.LookupState(0);
+  const auto* root = &info.RootVariable();
+
+  // index of (state id, variable id), or -1 if there is no such goto
+  HeapArray<int> transition_index{state_num * var_num, -1};
+  SmallVector<std::tuple<const ParserState*, const VariableInfo*>> transitions;
+
+  const auto make_transition = [&](const ParserState* state,
+                                   const VariableInfo* var) {
+    auto& index = transition_index[state->Id() * var_num + var->Id()];
+    if (index == -1) {
+      index = transitions.size();
+      transitions.push_back({state, var});
+    }
+
+    return index;
+  };
+
+  for (int id = 0; id < state_num; ++id) {
+    const auto* state = pda.LookupState(id);
+    for (const auto& pair : state->GotoMap()) {
+      make_transition(state, pair.first);
+    }
+  }
+
+  // reducing to root in the initial state is accepting the input, as if
+  // there were a goto on root followed by eof
+  const auto accept_transition = make_transition(initial_state, root);
+
+  const int transition_num = transitions.size();
+  SmallVector<Bitset> follow(transition_num, Bitset{eof_id + 1});
+  SmallVector<SmallVector<int>> reads(transition_num);
+  SmallVector<SmallVector<int>> includes(transition_num);
+  SmallVector<std::tuple<LocatedProduction, int>> lookbacks;
+
+  follow[accept_transition].set(eof_id);
+
+  for (int t = 0; t < transition_num; ++t) {
+    const auto [src, var] = transitions[t];
+
+    // DR and reads
+    if (auto it = src->GotoMap().find(var); it != src->GotoMap().end()) {
+      const auto* dest = it->second;
+
+      for (const auto& pair : dest->ActionMap()) {
+        assert(std::holds_alternative<PdaEdgeShift>(pair.second));
+        follow[t].set(pair.first->Id());
+      }
+      for (const auto& pair : dest->GotoMap()) {
+        if (nullable.test(pair.first->Id())) {
+          reads[t].push_back(
+              transition_index[dest->Id() * var_num + pair.first->Id()]);
         }
+      }
+    }
 
-        // for all term in FOLLOW do reduce
-        for (const auto* term : merged_follow.at(key)) {
-          state.RegisterReduce(production, term);
+    // includes and lookback, walking each production of var from src
+    for (const auto* production : var->Productions()) {
+      const auto& rhs = production->Right();
+
+      const auto* state = src;
+      for (int i = 0; i < rhs.size(); ++i) {
+        if (const auto* rhs_var = rhs[i]->AsVariable(); rhs_var) {
+          auto suffix_nullable =
+              std::all_of(rhs.begin() + i + 1, rhs.end(), [&](auto* s) {
+                const auto* v = s->AsVariable();
+                return v != nullptr && nullable.test(v->Id());
+              });
+
+          if (suffix_nullable) {
+            includes[transition_index[state->Id() * var_num + rhs_var->Id()]]
+                .push_back(t);
+          }
         }
+
+        state = LookupTargetState(state, rhs[i]);
       }
+
+      lookbacks.push_back({LocatedProduction{state, production}, t});
     }
+  }
+
+  SolveDigraph(reads, follow);
+  SolveDigraph(includes, follow);
+
+  LookaheadMap result;
+  for (const auto& [key, t] : lookbacks) {
+    auto& lookaheads =
+        result.try_emplace(key, Bitset{eof_id + 1}).first->second;
+    lookaheads |= follow[t];
+  }
+
+  return result;
+}
+
+auto BuildLALRAutomaton(const MetaInfo& info, const LALROptions& options)
+    -> std::unique_ptr<const ParserAutomaton> {
+  const auto closure = ClosureTable{info};
+
+  auto pda = BootstrapParsingAutomaton(info, closure, options.thread_pool);
+  const int eof_id = info.Tokens().size();
+
+  auto lookaheads =
+      options.lookahead == LookaheadAlgorithm::Relations
+          ? ComputeLookaheadsByRelations(info, *pda)
+          : ComputeLookaheadsByExtendedGrammar(info, closure, *pda);
+
+  // (state, lookahead) whose conflict has been resolved, any further
+  // reduction on it is a reduce/reduce conflict
+  std::set<std::tuple<const ParserState*, const TokenInfo*>> resolved;
+
+  const auto register_reduce = [&](ParserState& state,
+                                   const ProductionInfo* production,
+                                   const TokenInfo* term) {
+    auto it = state.ActionMap().find(term);
+    if (it == state.ActionMap().end()) {
+      state.RegisterReduce(production, term);
+      return;
+    }
+
+    if (resolved.count({&state, term}) != 0 ||
+        !std::holds_alternative<PdaEdgeShift>(it->second)) {
+      throw ParserConstructionError{
+          Format("BuildLALRAutomaton: reduce/reduce conflict on {} in state {}",
+                 term->Name(), state.Id())};
+    }
+
+    auto resolution = ResolveShiftReduce(*production, *term);
+    if (!resolution) {
+      throw ParserConstructionError{
+          Format("BuildLALRAutomaton: shift/reduce conflict on {} in state {}",
+                 term->Name(), state.Id())};
+    }
+
+    resolved.insert({&state, term});
+    if (*resolution == ConflictResolution::Reduce) {
+      state.RegisterReduce(production, term);
+    } else if (*resolution == ConflictResolution::Error) {
+      state.RegisterError(term);
+    }
+  };
+
+  const auto register_reductions = [&](ParserState& state,
+                                       const ProductionInfo* production) {
+    auto it = lookaheads.find(LocatedProduction{&state, production});
+    if (it == lookaheads.end()) {
+      return;
+    }
+
+    // EOF
+    if (it->second.test(eof_id)) {
+      if (state.EofAction()) {
+        throw ParserConstructionError{Format(
+            "BuildLALRAutomaton: reduce/reduce conflict on eof in state {}",
+            state.Id())};
+      }
+
+      state.RegisterReduceOnEof(production);
+    }
+
+    // for all term in FOLLOW do reduce
+    it->second.for_each([&](int id) {
+      if (id != eof_id) {
+        register_reduce(state, production, &info.Tokens()[id]);
+      }
+    });
+  };
+
+  // register reductions
+  pda->EnumerateState([&](const ItemSet& items, ParserState& state) {
+    for (auto item : items) {
+      if (item.IsFinalized()) {
+        register_reductions(state, item.Production());
+      }
+    }
+
+    // epsilon productions are reduced from the closure
+    closure.Enumerate(items, [&](ParserItem item) {
+      if (item.IsFinalized() && items.count(item) == 0) {
+        register_reductions(state, item.Production());
+      }
+    });
   });
 
+  if (options.eliminate_unit_productions) {
+    EliminateUnitProductions(info, *pda);
+  }
+
   return pda;
 }
 }  // namespace RG
\ No newline at end of file
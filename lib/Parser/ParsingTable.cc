@@ -0,0 +1,137 @@
+#include "RegGen/Parser/ParsingTable.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "RegGen/Common/BinaryStream.h"
+#include "RegGen/Container/SmallVector.h"
+
+namespace RG {
+
+auto RowDisplacementTable::Compress(ArrayRef<int32_t> dense, int col_num,
+                                    ArrayRef<int32_t> defaults)
+    -> RowDisplacementTable {
+  const int row_num = defaults.size();
+  assert(dense.size() == row_num * col_num);
+
+  RowDisplacementTable result;
+  result.col_num_ = col_num;
+  result.default_.initialize(row_num);
+  result.base_.initialize(row_num, 0);
+  std::copy(defaults.begin(), defaults.end(), result.default_.begin());
+
+  // columns of non-default entries of each row
+  SmallVector<SmallVector<int>> entries(row_num);
+  for (int row = 0; row < row_num; ++row) {
+    for (int col = 0; col < col_num; ++col) {
+      if (dense[row * col_num + col] != defaults[row]) {
+        entries[row].push_back(col);
+      }
+    }
+  }
+
+  // denser rows are harder to fit, so they are placed first
+  SmallVector<int> order(row_num);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int lhs, int rhs) {
+    return entries[lhs].size() > entries[rhs].size();
+  });
+
+  SmallVector<int32_t> check;
+  SmallVector<int32_t> value;
+  auto first_free = 0;
+  auto max_base = 0;
+
+  for (auto row : order) {
+    const auto& cols = entries[row];
+    if (cols.empty()) {
+      break;
+    }
+
+    // first fit, slots past the end are free
+    auto fits = [&](int base) {
+      return std::all_of(cols.begin(), cols.end(), [&](int col) {
+        return base + col >= check.size() || check[base + col] == -1;
+      });
+    };
+
+    auto base = std::max(0, first_free - cols.front());
+    while (!fits(base)) {
+      ++base;
+    }
+
+    if (base + col_num > check.size()) {
+      check.resize(base + col_num, -1);
+      value.resize(base + col_num, 0);
+    }
+
+    for (auto col : cols) {
+      check[base + col] = row;
+      value[base + col] = dense[row * col_num + col];
+    }
+
+    result.base_[row] = base;
+    max_base = std::max(max_base, base);
+
+    while (first_free < check.size() && check[first_free] != -1) {
+      ++first_free;
+    }
+  }
+
+  // any column of any row must index into the vector
+  check.resize(std::max<int>(check.size(), max_base + col_num), -1);
+  value.resize(check.size(), 0);
+
+  result.check_.initialize(check.size());
+  result.value_.initialize(value.size());
+  std::copy(check.begin(), check.end(), result.check_.begin());
+  std::copy(value.begin(), value.end(), result.value_.begin());
+
+  return result;
+}
+
+auto RowDisplacementTable::Serialize(BinaryWriter& writer) const -> void {
+  writer.WriteInt(col_num_);
+  writer.WriteArray(default_.begin(), default_.size());
+  writer.WriteArray(base_.begin(), base_.size());
+
+  writer.WriteInt(value_.size());
+  writer.WriteArray(check_.begin(), check_.size());
+  writer.WriteArray(value_.begin(), value_.size());
+}
+
+auto RowDisplacementTable::Deserialize(BinaryReader& reader, int row_num,
+                                       int col_num) -> RowDisplacementTable {
+  RowDisplacementTable result;
+
+  if (reader.ReadInt() != col_num) {
+    throw ParserConstructionError{"RowDisplacementTable: column count"};
+  }
+  result.col_num_ = col_num;
+
+  result.default_.initialize(row_num);
+  result.base_.initialize(row_num);
+  reader.ReadArray(result.default_.begin(), row_num);
+  reader.ReadArray(result.base_.begin(), row_num);
+
+  auto slot_num = reader.ReadCount(1 << 30);
+  result.check_.initialize(slot_num);
+  result.value_.initialize(slot_num);
+  reader.ReadArray(result.check_.begin(), slot_num);
+  reader.ReadArray(result.value_.begin(), slot_num);
+
+  for (auto base : result.base_) {
+    if (base < 0 || base > slot_num - col_num) {
+      throw ParserConstructionError{"RowDisplacementTable: invalid base"};
+    }
+  }
+  for (auto owner : result.check_) {
+    if (owner < -1 || owner >= row_num) {
+      throw ParserConstructionError{"RowDisplacementTable: invalid check"};
+    }
+  }
+
+  return result;
+}
+
+}  // namespace RG
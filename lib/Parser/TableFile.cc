@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "RegGen/Common/BinaryStream.h"
+#include "RegGen/Common/MappedFile.h"
+#include "RegGen/Parser/Parser.h"
+#include "RegGen/Parser/TypeInfo.h"
+
+namespace RG {
+
+// layout of a table file:
+//
+//   TableFileHeader
+//   payload: parser info skeleton, table dimensions, char classes,
+//            accepted tokens, lexing table, action tables, goto table
+//
+// all values are in native byte order, which the header records
+struct TableFileHeader {
+  char magic[4];
+  uint32_t byte_order;
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t payload_size;
+  uint64_t checksum;
+};
+
+constexpr char kTableFileMagic[4] = {'R', 'G', 'P', 'T'};
+constexpr uint32_t kTableFileByteOrder = 0x01020304;
+constexpr uint32_t kTableFileVersion = 2;
+
+auto CompiledGrammar::SerializeTables() const -> std::string {
+  if (lexer_mode_ == LexerMode::Lazy || lexer_mode_ == LexerMode::Nfa) {
+    throw ParserConstructionError{
+        "CompiledGrammar: no lexing table to serialize in lazy or nfa mode"};
+  }
+
+  BinaryWriter writer;
+  SerializeParserInfo(writer, *info_);
+
+  writer.WriteInt(token_num_);
+  writer.WriteInt(term_num_);
+  writer.WriteInt(nonterm_num_);
+  writer.WriteInt(char_class_num_);
+  writer.WriteInt(dfa_state_num_);
+  writer.WriteInt(pda_state_num_);
+
+  // lexing table
+  writer.WriteArray(char_classes_.Table().data(), CharClassMap::kAlphabetSize);
+
+  SmallVector<int> acc_token_ids;
+  for (const auto* token : acc_token_lookup_) {
+    acc_token_ids.push_back(token ? token->Id() : -1);
+  }
+  writer.WriteArray(acc_token_ids.data(), acc_token_ids.size());
+  writer.WriteArray(lexing_table_.begin(), lexing_table_.size());
+
+  // parsing table
+  action_table_.Serialize(writer);
+  writer.WriteArray(eof_action_table_.begin(), eof_action_table_.size());
+  goto_table_.Serialize(writer);
+
+  const auto& payload = writer.Buffer();
+
+  TableFileHeader header{};
+  std::memcpy(header.magic, kTableFileMagic, sizeof(header.magic));
+  header.byte_order = kTableFileByteOrder;
+  header.version = kTableFileVersion;
+  header.payload_size = payload.size();
+  header.checksum = ComputeChecksum(payload);
+
+  auto result = std::string(reinterpret_cast<const char*>(&header),
+                            sizeof(header));
+  result.append(payload);
+
+  return result;
+}
+
+auto CompiledGrammar::WriteTables(const std::string& path) const -> void {
+  auto data = SerializeTables();
+
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(data.data(), data.size());
+
+  if (!file) {
+    throw ParserConstructionError{"CompiledGrammar: cannot write table file"};
+  }
+}
+
+auto CompiledGrammar::LoadTables(std::string_view data,
+                                 const AST::ASTTypeProxyManager* env,
+                                 const ParserOptions& options)
+    -> std::unique_ptr<CompiledGrammar> {
+  TableFileHeader header;
+  if (data.size() < sizeof(header)) {
+    throw ParserConstructionError{"CompiledGrammar: table file too short"};
+  }
+
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, kTableFileMagic, sizeof(header.magic)) != 0) {
+    throw ParserConstructionError{"CompiledGrammar: not a table file"};
+  }
+  if (header.byte_order != kTableFileByteOrder) {
+    throw ParserConstructionError{"CompiledGrammar: table file byte order"};
+  }
+  if (header.version != kTableFileVersion) {
+    throw ParserConstructionError{"CompiledGrammar: table file version"};
+  }
+
+  auto payload = data.substr(sizeof(header));
+  if (payload.size() != header.payload_size ||
+      ComputeChecksum(payload) != header.checksum) {
+    throw ParserConstructionError{"CompiledGrammar: table file checksum"};
+  }
+
+  auto result = std::unique_ptr<CompiledGrammar>(new CompiledGrammar());
+  result->InitializeFromTables(payload, env, options);
+
+  return result;
+}
+
+auto CompiledGrammar::LoadTableFile(const std::string& path,
+                                    const AST::ASTTypeProxyManager* env,
+                                    const ParserOptions& options)
+    -> std::unique_ptr<CompiledGrammar> {
+  MappedFile file{path};
+
+  return LoadTables(file.Data(), env, options);
+}
+
+auto GenericParser::LoadTables(std::string_view data,
+                               const AST::ASTTypeProxyManager* env,
+                               const ParserOptions& options)
+    -> std::unique_ptr<GenericParser> {
+  return std::make_unique<GenericParser>(
+      CompiledGrammar::LoadTables(data, env, options));
+}
+
+auto GenericParser::LoadTableFile(const std::string& path,
+                                  const AST::ASTTypeProxyManager* env,
+                                  const ParserOptions& options)
+    -> std::unique_ptr<GenericParser> {
+  return std::make_unique<GenericParser>(
+      CompiledGrammar::LoadTableFile(path, env, options));
+}
+
+auto CompiledGrammar::InitializeFromTables(std::string_view payload,
+                                           const AST::ASTTypeProxyManager* env,
+                                           const ParserOptions& options)
+    -> void {
+  BinaryReader reader{payload};
+  info_ = DeserializeParserInfo(reader, env);
+
+  token_num_ = reader.ReadInt();
+  term_num_ = reader.ReadInt();
+  nonterm_num_ = reader.ReadInt();
+  char_class_num_ = reader.ReadInt();
+  dfa_state_num_ = reader.ReadInt();
+  pda_state_num_ = reader.ReadInt();
+
+  if (term_num_ != info_->Tokens().size() ||
+      token_num_ != term_num_ + info_->IgnoredTokens().size() ||
+      nonterm_num_ != info_->Variables().size() || char_class_num_ <= 0 ||
+      char_class_num_ > CharClassMap::kAlphabetSize || dfa_state_num_ < 0 ||
+      pda_state_num_ <= 0) {
+    throw ParserConstructionError{"CompiledGrammar: invalid table dimensions"};
+  }
+
+  auto check_range = [](const int* begin, const int* end, int min, int max) {
+    for (const auto* p = begin; p != end; ++p) {
+      if (*p < min || *p > max) {
+        throw ParserConstructionError{"CompiledGrammar: invalid table entry"};
+      }
+    }
+  };
+
+  // lexing table
+  Array<uint8_t, CharClassMap::kAlphabetSize> class_table;
+  reader.ReadArray(class_table.data(), class_table.size());
+  for (auto cls : class_table) {
+    if (cls >= char_class_num_) {
+      throw ParserConstructionError{"CompiledGrammar: invalid char class"};
+    }
+  }
+  char_classes_ = CharClassMap::FromTable(class_table);
+
+  HeapArray<int> acc_token_ids{dfa_state_num_};
+  reader.ReadArray(acc_token_ids.begin(), dfa_state_num_);
+  check_range(acc_token_ids.begin(), acc_token_ids.end(), -1, token_num_ - 1);
+
+  acc_token_lookup_.initialize(dfa_state_num_, nullptr);
+  for (int id = 0; id < dfa_state_num_; ++id) {
+    auto token_id = acc_token_ids[id];
+    if (token_id >= term_num_) {
+      acc_token_lookup_[id] = &info_->IgnoredTokens()[token_id - term_num_];
+    } else if (token_id >= 0) {
+      acc_token_lookup_[id] = &info_->Tokens()[token_id];
+    }
+  }
+
+  lexing_table_.initialize(char_class_num_ * dfa_state_num_);
+  reader.ReadArray(lexing_table_.begin(), lexing_table_.size());
+  check_range(lexing_table_.begin(), lexing_table_.end(), -1,
+              dfa_state_num_ - 1);
+  InitializeSentinel();
+
+  // parsing table
+  const int production_num = info_->Productions().size();
+  auto check_action = [&](PackedAction action) {
+    if ((IsShiftAction(action) && ShiftTarget(action) >= pda_state_num_) ||
+        (IsReduceAction(action) &&
+         ReduceProduction(action) >= production_num)) {
+      throw ParserConstructionError{"CompiledGrammar: invalid parser action"};
+    }
+  };
+
+  action_table_ =
+      RowDisplacementTable::Deserialize(reader, pda_state_num_, term_num_);
+  action_table_.ForEachValue(check_action);
+
+  eof_action_table_.initialize(pda_state_num_);
+  reader.ReadArray(eof_action_table_.begin(), eof_action_table_.size());
+  std::for_each(eof_action_table_.begin(), eof_action_table_.end(),
+                check_action);
+
+  goto_table_ =
+      RowDisplacementTable::Deserialize(reader, nonterm_num_, pda_state_num_);
+  goto_table_.ForEachValue([&](int32_t target) {
+    if (target < -1 || target >= pda_state_num_) {
+      throw ParserConstructionError{"CompiledGrammar: invalid goto target"};
+    }
+  });
+
+  if (!reader.Exhausted()) {
+    throw ParserConstructionError{"CompiledGrammar: trailing table data"};
+  }
+
+  InitializeProductionTable();
+  InitializeDefaultReductions();
+
+  // lexer
+  lexer_mode_ = LexerMode::Eager;
+  scanner_ = options.scanner;
+  pipeline_threshold_ = options.pipeline_threshold;
+  if (scanner_ != nullptr) {
+    lexer_mode_ = LexerMode::Direct;
+  } else if (dfa_state_num_ == 0) {
+    throw ParserConstructionError{
+        "CompiledGrammar: table file has no lexing table, a scanner is needed"};
+  }
+}
+
+}  // namespace RG
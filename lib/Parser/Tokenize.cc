@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "RegGen/Common/ThreadPool.h"
+#include "RegGen/Container/SmallVector.h"
+#include "RegGen/Parser/Parser.h"
+
+namespace RG {
+
+namespace {
+
+// chunks are never cut smaller than this, so that speculation pays off
+constexpr int kMinChunkSize = 1 << 16;
+
+// chunks per worker, to even out chunks that lex slower than others
+constexpr int kChunksPerWorker = 4;
+
+// tokens of a chunk as if one started right at its beginning
+struct SpeculativeChunk {
+  int begin;
+  int end;
+
+  // tokens starting before end, the last may run past it
+  std::vector<AST::BasicASTToken> tokens;
+
+  // offset at which no token matched, or -1
+  int failed_at = -1;
+};
+
+[[noreturn]] auto ThrowInvalidToken() -> void {
+  throw ParserInternalError{"CompiledGrammar: invalid token encountered"};
+}
+
+}  // namespace
+
+auto CompiledGrammar::Tokenize(const std::string& data, TokenFilter filter,
+                               ThreadPool* pool) const -> TokenBuffer {
+  // without a pool speculation only adds work, so the input is one chunk
+  const int chunk_num =
+      pool == nullptr
+          ? 1
+          : std::max<int>(1, std::min<int>(
+                                 data.length() / kMinChunkSize,
+                                 (pool->ThreadCount() + 1) * kChunksPerWorker));
+  const int chunk_size = (data.length() + chunk_num - 1) / chunk_num;
+
+  auto kept = [&](const AST::BasicASTToken& tok) {
+    return filter == TokenFilter::All || tok.Tag() < term_num_;
+  };
+
+  if (chunk_num == 1) {
+    LexerContext lexer;
+    PrepareLexerContext(lexer);
+
+    TokenBuffer result;
+    for (int offset = 0; offset < data.length();) {
+      auto tok = LoadTerminatedToken(lexer, data, offset);
+      if (!tok.IsValid()) {
+        ThrowInvalidToken();
+      }
+
+      offset = tok.Offset() + tok.Length();
+      if (kept(tok)) {
+        result.Append(tok);
+      }
+    }
+
+    return result;
+  }
+
+  // tokenization from an offset does not depend on what came before, as
+  // every token is matched from the initial state. a chunk lexed from its
+  // first byte is right from the first token whose offset the true stream
+  // reaches, often a whitespace or two in
+  SmallVector<SpeculativeChunk> chunks(chunk_num);
+  ParallelFor(pool, chunk_num, [&](int k) {
+    auto& chunk = chunks[k];
+    chunk.begin = k * chunk_size;
+    chunk.end = std::min<int>(data.length(), chunk.begin + chunk_size);
+
+    LexerContext lexer;
+    PrepareLexerContext(lexer);
+    for (int offset = chunk.begin; offset < chunk.end;) {
+      auto tok = LoadTerminatedToken(lexer, data, offset);
+      if (!tok.IsValid()) {
+        chunk.failed_at = offset;
+        break;
+      }
+
+      chunk.tokens.push_back(tok);
+      offset = tok.Offset() + tok.Length();
+    }
+  });
+
+  // walk the true stream from chunk to chunk, lexing it here only until it
+  // meets a speculative token start. first_true[k] is the first token of
+  // chunk k on the true stream, fixups[k] the tokens lexed here before it
+  SmallVector<int> first_true(chunk_num);
+  SmallVector<std::vector<AST::BasicASTToken>> fixups(chunk_num);
+
+  LexerContext lexer;
+  PrepareLexerContext(lexer);
+
+  int offset = 0;
+  for (int k = 0; k < chunk_num; ++k) {
+    const auto& chunk = chunks[k];
+    const auto& tokens = chunk.tokens;
+
+    auto it = tokens.begin();
+    while (true) {
+      it = std::lower_bound(it, tokens.end(), offset,
+                            [](const auto& tok, int target) {
+                              return tok.Offset() < target;
+                            });
+
+      if (it != tokens.end() && it->Offset() == offset) {
+        // in sync, the rest of the chunk is right, failure included
+        if (chunk.failed_at >= 0) {
+          ThrowInvalidToken();
+        }
+
+        offset = tokens.back().Offset() + tokens.back().Length();
+        break;
+      }
+      if (offset == chunk.failed_at) {
+        ThrowInvalidToken();
+      }
+      if (offset >= chunk.end) {
+        // a token from before ran over the whole chunk
+        break;
+      }
+
+      auto tok = LoadTerminatedToken(lexer, data, offset);
+      if (!tok.IsValid()) {
+        ThrowInvalidToken();
+      }
+
+      fixups[k].push_back(tok);
+      offset = tok.Offset() + tok.Length();
+    }
+
+    first_true[k] = it - tokens.begin();
+  }
+
+  // concatenate in parallel, each chunk knowing where its tokens go
+  auto for_each_true = [&](int k, auto f) {
+    const auto& tokens = chunks[k].tokens;
+
+    std::for_each(fixups[k].begin(), fixups[k].end(), f);
+    std::for_each(tokens.begin() + first_true[k], tokens.end(), f);
+  };
+
+  SmallVector<int> output_begin(chunk_num + 1, 0);
+  ParallelFor(pool, chunk_num, [&](int k) {
+    auto& count = output_begin[k + 1];
+    for_each_true(k, [&](const auto& tok) { count += kept(tok); });
+  });
+  for (int k = 0; k < chunk_num; ++k) {
+    output_begin[k + 1] += output_begin[k];
+  }
+
+  TokenBuffer result;
+  result.Resize(output_begin[chunk_num]);
+  ParallelFor(pool, chunk_num, [&](int k) {
+    auto index = output_begin[k];
+    for_each_true(k, [&](const auto& tok) {
+      if (kept(tok)) {
+        result.Assign(index++, tok);
+      }
+    });
+  });
+
+  return result;
+}
+
+}  // namespace RG
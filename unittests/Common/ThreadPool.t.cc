@@ -0,0 +1,66 @@
+#include "RegGen/Common/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace RG {
+namespace {
+
+TEST(ThreadPool, ParallelFor) {
+  ThreadPool pool{4};
+
+  std::vector<int> hits(10000, 0);
+  pool.ParallelFor(hits.size(), [&](int i) { hits[i] += 1; });
+
+  for (auto hit : hits) {
+    EXPECT_EQ(hit, 1);
+  }
+}
+
+TEST(ThreadPool, NestedParallelFor) {
+  // every worker blocks in an inner loop, which must still finish
+  ThreadPool pool{2};
+
+  std::atomic<int> sum = 0;
+  pool.ParallelFor(8, [&](int i) {
+    pool.ParallelFor(100, [&](int j) { sum += i * j; });
+  });
+
+  EXPECT_EQ(sum, 28 * 4950);
+}
+
+TEST(ThreadPool, Submit) {
+  ThreadPool pool{3};
+
+  std::atomic<int> count = 0;
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.push_back(pool.Submit([&] { count += 1; }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  EXPECT_EQ(count, 100);
+}
+
+TEST(ThreadPool, Exception) {
+  ThreadPool pool{2};
+
+  EXPECT_THROW(pool.ParallelFor(1000,
+                                [](int i) {
+                                  if (i == 500) {
+                                    throw std::runtime_error{"failed"};
+                                  }
+                                }),
+               std::runtime_error);
+
+  auto future = pool.Submit([] { throw std::runtime_error{"failed"}; });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+}  // namespace
+}  // namespace RG
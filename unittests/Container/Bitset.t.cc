@@ -0,0 +1,94 @@
+#include "RegGen/Container/Bitset.h"
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+namespace RG {
+namespace {
+
+TEST(Bitset, SetAndTest) {
+  Bitset bits{130};
+
+  EXPECT_EQ(bits.size(), 130);
+  EXPECT_EQ(bits.word_count(), 3);
+  EXPECT_TRUE(bits.none());
+
+  bits.set(0);
+  bits.set(64);
+  bits.set(129);
+
+  EXPECT_TRUE(bits.test(0));
+  EXPECT_TRUE(bits.test(64));
+  EXPECT_TRUE(bits.test(129));
+  EXPECT_FALSE(bits.test(1));
+  EXPECT_EQ(bits.count(), 3);
+
+  bits.reset(64);
+  EXPECT_FALSE(bits.test(64));
+  EXPECT_EQ(bits.count(), 2);
+
+  bits.clear();
+  EXPECT_TRUE(bits.none());
+}
+
+TEST(Bitset, Iterate) {
+  Bitset bits{200};
+  for (auto pos : {3, 63, 64, 150, 199}) {
+    bits.set(pos);
+  }
+
+  SmallVector<int> visited;
+  bits.for_each([&](int pos) { visited.push_back(pos); });
+  EXPECT_EQ(visited, (SmallVector<int>{3, 63, 64, 150, 199}));
+
+  EXPECT_EQ(bits.find_first(), 3);
+  EXPECT_EQ(bits.find_next(4), 63);
+  EXPECT_EQ(bits.find_next(65), 150);
+  EXPECT_EQ(bits.find_next(200), Bitset::npos);
+  EXPECT_EQ(Bitset{10}.find_first(), Bitset::npos);
+}
+
+TEST(Bitset, SetOperations) {
+  Bitset lhs{100};
+  Bitset rhs{100};
+  lhs.set(1);
+  lhs.set(70);
+  rhs.set(70);
+  rhs.set(99);
+
+  EXPECT_TRUE(lhs.intersects(rhs));
+
+  auto merged = lhs;
+  EXPECT_TRUE(merged.unite(rhs));
+  EXPECT_FALSE(merged.unite(rhs));
+  EXPECT_EQ(merged.count(), 3);
+
+  auto common = lhs;
+  common &= rhs;
+  EXPECT_EQ(common.count(), 1);
+  EXPECT_TRUE(common.test(70));
+
+  rhs.reset(70);
+  EXPECT_FALSE(lhs.intersects(rhs));
+}
+
+TEST(Bitset, Hash) {
+  Bitset lhs{100};
+  Bitset rhs{100};
+  lhs.set(42);
+  rhs.set(42);
+
+  EXPECT_EQ(lhs, rhs);
+  EXPECT_EQ(lhs.hash(), rhs.hash());
+
+  std::unordered_set<Bitset, Bitset::Hash> lookup{lhs};
+  EXPECT_EQ(lookup.count(rhs), 1);
+
+  rhs.set(43);
+  EXPECT_NE(lhs, rhs);
+  EXPECT_EQ(lookup.count(rhs), 0);
+}
+
+}  // namespace
+}  // namespace RG
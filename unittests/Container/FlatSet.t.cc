@@ -0,0 +1,80 @@
+#include "RegGen/Container/FlatSet.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace RG {
+namespace {
+
+auto Elements(const FlatSet<int>& set) -> std::vector<int> {
+  return {set.begin(), set.end()};
+}
+
+TEST(FlatSet, Insert) {
+  FlatSet<int> set;
+
+  auto [where, inserted] = set.insert(3);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*where, 3);
+
+  set.insert(1);
+  auto [again, again_inserted] = set.insert(3);
+  EXPECT_FALSE(again_inserted);
+  EXPECT_EQ(*again, 3);
+
+  // a right hint is taken as is, a wrong one is ignored
+  EXPECT_EQ(*set.insert(set.end(), 5), 5);
+  EXPECT_EQ(*set.insert(set.begin(), 4), 4);
+  EXPECT_EQ(*set.insert(set.begin(), 1), 1);
+
+  EXPECT_EQ(Elements(set), (std::vector<int>{1, 3, 4, 5}));
+  EXPECT_EQ(std::vector<int>(set.rbegin(), set.rend()),
+            (std::vector<int>{5, 4, 3, 1}));
+}
+
+TEST(FlatSet, BulkConstruct) {
+  std::vector<int> values = {5, 3, 5, 1, 3, 9};
+
+  FlatSet<int> set{values.begin(), values.end()};
+  EXPECT_EQ(Elements(set), (std::vector<int>{1, 3, 5, 9}));
+
+  set.insert({7, 1, 2, 7});
+  EXPECT_EQ(Elements(set), (std::vector<int>{1, 2, 3, 5, 7, 9}));
+}
+
+TEST(FlatSet, Unite) {
+  FlatSet<int> set = {1, 4, 7};
+
+  EXPECT_TRUE(set.unite(FlatSet<int>{2, 4, 8}));
+  EXPECT_EQ(Elements(set), (std::vector<int>{1, 2, 4, 7, 8}));
+
+  EXPECT_FALSE(set.unite(FlatSet<int>{1, 8}));
+  EXPECT_FALSE(set.unite(FlatSet<int>{}));
+  EXPECT_EQ(set.size(), 5);
+
+  std::vector<int> sorted = {0, 9};
+  EXPECT_TRUE(set.unite(sorted.begin(), sorted.end()));
+  EXPECT_EQ(Elements(set), (std::vector<int>{0, 1, 2, 4, 7, 8, 9}));
+}
+
+TEST(FlatSet, IntersectAndSubtract) {
+  const FlatSet<int> other = {2, 3, 5, 8};
+
+  FlatSet<int> common = {1, 2, 3, 4, 5};
+  EXPECT_TRUE(common.intersect(other));
+  EXPECT_EQ(Elements(common), (std::vector<int>{2, 3, 5}));
+  EXPECT_FALSE(common.intersect(other));
+
+  FlatSet<int> rest = {1, 2, 3, 4, 5};
+  EXPECT_TRUE(rest.subtract(other));
+  EXPECT_EQ(Elements(rest), (std::vector<int>{1, 4}));
+  EXPECT_FALSE(rest.subtract(other));
+
+  EXPECT_TRUE(common.intersects(other));
+  EXPECT_FALSE(rest.intersects(other));
+  EXPECT_FALSE(rest.intersects(FlatSet<int>{}));
+}
+
+}  // namespace
+}  // namespace RG
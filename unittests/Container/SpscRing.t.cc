@@ -0,0 +1,68 @@
+#include "RegGen/Container/SpscRing.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace RG {
+namespace {
+
+TEST(SpscRing, FullAndEmpty) {
+  SpscRing<int> ring{3};
+  EXPECT_EQ(ring.Capacity(), 4);
+  EXPECT_EQ(ring.Front(), nullptr);
+
+  for (int i = 0; i < 4; ++i) {
+    auto* slot = ring.Back();
+    ASSERT_NE(slot, nullptr);
+    *slot = i;
+    ring.Push();
+  }
+  EXPECT_EQ(ring.Back(), nullptr);
+
+  // slots are handed out again once popped, in order
+  for (int i = 0; i < 6; ++i) {
+    auto* slot = ring.Front();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(*slot, i);
+    ring.Pop();
+
+    if (i < 2) {
+      *ring.Back() = i + 4;
+      ring.Push();
+    }
+  }
+  EXPECT_EQ(ring.Front(), nullptr);
+}
+
+TEST(SpscRing, TwoThreads) {
+  constexpr int kCount = 100000;
+  SpscRing<int> ring{8};
+
+  std::thread producer{[&] {
+    for (int i = 0; i < kCount;) {
+      if (auto* slot = ring.Back(); slot) {
+        *slot = i++;
+        ring.Push();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }};
+
+  auto in_order = true;
+  for (int expected = 0; expected < kCount;) {
+    if (auto* slot = ring.Front(); slot) {
+      in_order &= *slot == expected++;
+      ring.Pop();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  EXPECT_TRUE(in_order);
+}
+
+}  // namespace
+}  // namespace RG
@@ -0,0 +1,87 @@
+#include "RegGen/Lexer/BitParallelNfa.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "RegGen/Lexer/LexerAutomaton.h"
+#include "RegGen/Parser/MetaInfo.h"
+
+namespace RG {
+namespace {
+
+auto MatchLongest(const BitParallelNfa& nfa, const std::string& text) -> int {
+  auto result = -1;
+
+  auto state = nfa.InitialState();
+  auto next_state = Bitset{nfa.PositionCount()};
+  for (auto ch : text) {
+    nfa.Transit(state, ch, next_state);
+    std::swap(state, next_state);
+    if (state.none()) {
+      break;
+    }
+
+    if (const auto* token = nfa.AcceptedToken(state); token) {
+      result = token->Id();
+    }
+  }
+
+  return result;
+}
+
+auto MatchLongest(const LexerAutomaton& dfa, const std::string& text) -> int {
+  auto result = -1;
+
+  const auto* state = dfa.LookupState(0);
+  for (auto ch : text) {
+    state = state->LookupTransition(ch);
+    if (state == nullptr) {
+      break;
+    }
+
+    if (state->acc_token) {
+      result = state->acc_token->Id();
+    }
+  }
+
+  return result;
+}
+
+TEST(BitParallelNfa, MatchEagerAutomaton) {
+  auto info = ResolveParserInfo(
+      "token k_if = \"if\";"
+      "token k_int = \"int\";"
+      "token num = \"[0-9]+(\\\\.[0-9]+)?\";"
+      "token id = \"[_a-zA-Z][_a-zA-Z0-9]*\";"
+      "token s = \"ab?c\";"
+      "ignore ws = \"[ \t]+\";",
+      nullptr);
+  auto pa = BuildPositionAutomaton(*info);
+  auto dfa = BuildLexerAutomaton(*pa);
+
+  BitParallelNfa nfa{pa.get()};
+  for (const auto* sample : {"if", "int", "i", "iff", "in_t", "0", "1.5",
+                             "1.", "12a", " \t ", "_", "", "+", "ac", "abc"}) {
+    EXPECT_EQ(MatchLongest(nfa, sample), MatchLongest(*dfa, sample)) << sample;
+  }
+}
+
+TEST(BitParallelNfa, ExponentialDeterminization) {
+  // the dfa has to remember the last 8 chars
+  auto info = ResolveParserInfo(
+      "token t = \"(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)\";", nullptr);
+  auto pa = BuildPositionAutomaton(*info);
+
+  EXPECT_EQ(BuildLexerAutomaton(*pa, 64), nullptr);
+  EXPECT_NE(BuildLexerAutomaton(*pa, 1024), nullptr);
+
+  BitParallelNfa nfa{pa.get()};
+  EXPECT_EQ(MatchLongest(nfa, "abbbbbbb"), 0);
+  EXPECT_EQ(MatchLongest(nfa, "bbabbbbbbb"), 0);
+  EXPECT_EQ(MatchLongest(nfa, "bbbbbbbbb"), -1);
+  EXPECT_EQ(MatchLongest(nfa, "abbbbbb"), -1);
+}
+
+}  // namespace
+}  // namespace RG
@@ -0,0 +1,105 @@
+#include "RegGen/Lexer/LazyDfa.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "RegGen/Lexer/LexerAutomaton.h"
+#include "RegGen/Parser/MetaInfo.h"
+
+namespace RG {
+namespace {
+
+const char* const kKeywordConfig =
+    "token k_if = \"if\";"
+    "token k_int = \"int\";"
+    "token k_in = \"in\";"
+    "token num = \"[0-9]+\";"
+    "token id = \"[_a-zA-Z][_a-zA-Z0-9]*\";"
+    "ignore ws = \"[ \t]+\";";
+
+auto MatchLongest(LazyDfa& dfa, const std::string& text) -> int {
+  auto result = -1;
+
+  auto state = dfa.InitialState();
+  for (auto ch : text) {
+    state = dfa.Transit(state, ch);
+    if (state == LazyDfa::kDeadState) {
+      break;
+    }
+
+    if (const auto* token = dfa.AcceptedToken(state); token) {
+      result = token->Id();
+    }
+  }
+
+  return result;
+}
+
+auto MatchLongest(const LexerAutomaton& dfa, const std::string& text) -> int {
+  auto result = -1;
+
+  const auto* state = dfa.LookupState(0);
+  for (auto ch : text) {
+    state = state->LookupTransition(ch);
+    if (state == nullptr) {
+      break;
+    }
+
+    if (state->acc_token) {
+      result = state->acc_token->Id();
+    }
+  }
+
+  return result;
+}
+
+const char* const kSamples[] = {
+    "if",  "int",  "in",   "i",   "iff", "in_t", "intx", "0",
+    "123", "12a",  " \t ", "_",   "",    "+",    "if0",  "Zz9",
+};
+
+TEST(LazyDfa, MatchEagerAutomaton) {
+  auto info = ResolveParserInfo(kKeywordConfig, nullptr);
+  auto pa = BuildPositionAutomaton(*info);
+  auto eager = BuildLexerAutomaton(*pa);
+
+  LazyDfa lazy{pa.get(), 1024};
+  for (const auto* sample : kSamples) {
+    EXPECT_EQ(MatchLongest(lazy, sample), MatchLongest(*eager, sample))
+        << sample;
+  }
+
+  EXPECT_EQ(lazy.FlushCount(), 0);
+  EXPECT_LE(lazy.CachedStateCount(), eager->UnminimizedStateCount());
+}
+
+TEST(LazyDfa, FlushWhenCacheIsFull) {
+  auto info = ResolveParserInfo(kKeywordConfig, nullptr);
+  auto pa = BuildPositionAutomaton(*info);
+  auto eager = BuildLexerAutomaton(*pa);
+
+  LazyDfa lazy{pa.get(), 2};
+  for (const auto* sample : kSamples) {
+    EXPECT_EQ(MatchLongest(lazy, sample), MatchLongest(*eager, sample))
+        << sample;
+  }
+
+  EXPECT_GT(lazy.FlushCount(), 0);
+  EXPECT_LE(lazy.CachedStateCount(), 2);
+}
+
+TEST(LazyDfa, ReuseCachedStates) {
+  auto info = ResolveParserInfo(kKeywordConfig, nullptr);
+  auto pa = BuildPositionAutomaton(*info);
+
+  LazyDfa lazy{pa.get(), 1024};
+  MatchLongest(lazy, "int");
+  auto count = lazy.CachedStateCount();
+
+  MatchLongest(lazy, "int");
+  EXPECT_EQ(lazy.CachedStateCount(), count);
+}
+
+}  // namespace
+}  // namespace RG
@@ -0,0 +1,148 @@
+#include "RegGen/Lexer/LexerAutomaton.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "RegGen/Common/ThreadPool.h"
+#include "RegGen/Parser/MetaInfo.h"
+
+namespace RG {
+namespace {
+
+// returns id of the longest token matched at the beginning of text
+auto MatchLongest(const LexerAutomaton& dfa, const std::string& text) -> int {
+  auto result = -1;
+
+  const auto* state = dfa.LookupState(0);
+  for (auto ch : text) {
+    state = state->LookupTransition(ch);
+    if (state == nullptr) {
+      break;
+    }
+
+    if (state->acc_token) {
+      result = state->acc_token->Id();
+    }
+  }
+
+  return result;
+}
+
+TEST(LexerAutomaton, MergeEquivalentStates) {
+  auto info = ResolveParserInfo("token t = \"ab|cb\";", nullptr);
+  auto dfa = BuildLexerAutomaton(*info);
+
+  EXPECT_EQ(dfa->UnminimizedStateCount(), 4);
+  EXPECT_EQ(dfa->StateCount(), 3);
+
+  EXPECT_EQ(MatchLongest(*dfa, "ab"), 0);
+  EXPECT_EQ(MatchLongest(*dfa, "cb"), 0);
+  EXPECT_EQ(MatchLongest(*dfa, "bb"), -1);
+}
+
+TEST(LexerAutomaton, NullableSequenceElement) {
+  auto info = ResolveParserInfo("token t = \"ab?c\";", nullptr);
+  auto dfa = BuildLexerAutomaton(*info);
+
+  EXPECT_EQ(MatchLongest(*dfa, "abc"), 0);
+  EXPECT_EQ(MatchLongest(*dfa, "ac"), 0);
+  EXPECT_EQ(MatchLongest(*dfa, "abbc"), -1);
+}
+
+TEST(LexerAutomaton, KeepTokenCategories) {
+  auto info = ResolveParserInfo(
+      "token k_if = \"if\";"
+      "token k_int = \"int\";"
+      "token id = \"[_a-zA-Z][_a-zA-Z0-9]*\";"
+      "ignore ws = \"[ \t]+\";",
+      nullptr);
+  auto dfa = BuildLexerAutomaton(*info);
+
+  EXPECT_LE(dfa->StateCount(), dfa->UnminimizedStateCount());
+
+  EXPECT_EQ(MatchLongest(*dfa, "if"), 0);
+  EXPECT_EQ(MatchLongest(*dfa, "int"), 1);
+  EXPECT_EQ(MatchLongest(*dfa, "i"), 2);
+  EXPECT_EQ(MatchLongest(*dfa, "iff"), 2);
+  EXPECT_EQ(MatchLongest(*dfa, "in_t"), 2);
+  EXPECT_EQ(MatchLongest(*dfa, " \t "), 3);
+  EXPECT_EQ(MatchLongest(*dfa, "0"), -1);
+}
+
+TEST(LexerAutomaton, RangeTransitions) {
+  auto info = ResolveParserInfo("token id = \"[_a-zA-Z][_a-zA-Z0-9]*\";",
+                                nullptr);
+  auto dfa = BuildLexerAutomaton(*info);
+
+  const auto& edges = dfa->LookupState(0)->transitions;
+  ASSERT_EQ(edges.size(), 3);
+
+  EXPECT_EQ(edges[0].range.Min(), 'A');
+  EXPECT_EQ(edges[0].range.Max(), 'Z');
+  EXPECT_EQ(edges[1].range.Min(), '_');
+  EXPECT_EQ(edges[1].range.Max(), '_');
+  EXPECT_EQ(edges[2].range.Min(), 'a');
+  EXPECT_EQ(edges[2].range.Max(), 'z');
+}
+
+TEST(LexerAutomaton, CharClasses) {
+  auto classes = CharClassMap::Compute(
+      {CharRange{'a', 'z'}, CharRange{'0', '9'}, CharRange{'x'}});
+
+  // unused bytes, [a-wyz], [0-9] and x
+  EXPECT_EQ(classes.ClassCount(), 4);
+
+  EXPECT_EQ(classes.Lookup('a'), classes.Lookup('z'));
+  EXPECT_EQ(classes.Lookup('0'), classes.Lookup('9'));
+  EXPECT_EQ(classes.Lookup(' '), classes.Lookup('\xff'));
+  EXPECT_NE(classes.Lookup('a'), classes.Lookup('x'));
+  EXPECT_NE(classes.Lookup('a'), classes.Lookup('0'));
+  EXPECT_NE(classes.Lookup('a'), classes.Lookup(' '));
+}
+
+TEST(LexerAutomaton, ParallelConstruction) {
+  // enough states for several batches of subset construction
+  std::string config;
+  for (int i = 0; i < 100; ++i) {
+    std::string word;
+    for (int n = i * 7919 + 1; word.size() < 6; n /= 5) {
+      word += static_cast<char>('a' + n % 5 + word.size());
+    }
+    config += "token t" + std::to_string(i) + " = \"" + word + "\";";
+  }
+  config += "token id = \"[a-z]+\";";
+
+  auto info = ResolveParserInfo(config, nullptr);
+  auto pa = BuildPositionAutomaton(*info);
+  auto expected = BuildLexerAutomaton(*pa);
+  ASSERT_GT(expected->UnminimizedStateCount(), 256);
+
+  for (auto thread_num : {1, 2, 4}) {
+    ThreadPool pool{thread_num};
+    auto dfa = BuildLexerAutomaton(*pa, 0, &pool);
+
+    ASSERT_EQ(dfa->StateCount(), expected->StateCount());
+    EXPECT_EQ(dfa->UnminimizedStateCount(),
+              expected->UnminimizedStateCount());
+
+    for (int id = 0; id < dfa->StateCount(); ++id) {
+      const auto* state = dfa->LookupState(id);
+      const auto* expected_state = expected->LookupState(id);
+
+      EXPECT_EQ(state->acc_token, expected_state->acc_token);
+      ASSERT_EQ(state->transitions.size(), expected_state->transitions.size());
+      for (int i = 0; i < state->transitions.size(); ++i) {
+        const auto& edge = state->transitions[i];
+        const auto& expected_edge = expected_state->transitions[i];
+
+        EXPECT_EQ(edge.range.Min(), expected_edge.range.Min());
+        EXPECT_EQ(edge.range.Max(), expected_edge.range.Max());
+        EXPECT_EQ(edge.target->id, expected_edge.target->id);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace RG
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "LangGrammar.h"
+#include "RegGen/Parser/Parser.h"
+
+namespace RG::Test {
+namespace {
+
+// tokens the generated scanner finds from offset 0, up to the first offset
+// where nothing matches
+auto ScanAll(const std::string& text, int* failed_at = nullptr)
+    -> std::vector<AST::BasicASTToken> {
+  std::vector<AST::BasicASTToken> result;
+  for (int offset = 0; offset < text.length();) {
+    auto tok = ScanToken(text, offset);
+    if (!tok.IsValid()) {
+      if (failed_at != nullptr) {
+        *failed_at = offset;
+      }
+      break;
+    }
+
+    result.push_back(tok);
+    offset = tok.Offset() + tok.Length();
+  }
+
+  return result;
+}
+
+auto SameTokens(const std::vector<AST::BasicASTToken>& lhs,
+                const TokenBuffer& rhs) -> bool {
+  if (lhs.size() != rhs.Size()) {
+    return false;
+  }
+
+  for (int i = 0; i < rhs.Size(); ++i) {
+    if (lhs[i].Offset() != rhs[i].Offset() ||
+        lhs[i].Length() != rhs[i].Length() || lhs[i].Tag() != rhs[i].Tag()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+TEST(DirectScanner, SameTokensAsEager) {
+  ParserOptions options;
+  options.lexer_mode = LexerMode::Eager;
+  const CompiledGrammar eager{LangConfig(), &LangProxyManager(), options};
+  ASSERT_EQ(eager.ActiveLexerMode(), LexerMode::Eager);
+
+  options.scanner = &ScanToken;
+  const CompiledGrammar direct{LangConfig(), &LangProxyManager(), options};
+  ASSERT_EQ(direct.ActiveLexerMode(), LexerMode::Direct);
+
+  // the scanner reads past an accepted token and falls back to it, as in
+  // "-" before "1", "<" before "x" or "=" before " "
+  for (const std::string text :
+       {std::string{kLangSample}, std::string{"x-1 x->y a<x b<=c d=e f==g"},
+        std::string{"a!=b&&c||d&e|f iff if_ while0 0while"}}) {
+    const auto expected = eager.Tokenize(text);
+
+    int failed_at = -1;
+    EXPECT_TRUE(SameTokens(ScanAll(text, &failed_at), expected)) << text;
+    EXPECT_EQ(failed_at, -1) << text;
+    EXPECT_TRUE(SameTokens(ScanAll(text), direct.Tokenize(text))) << text;
+  }
+
+  // "!" is only a prefix of "!=", so nothing matches at it, nor at "@"
+  for (const std::string text : {"val x = 1 @ 2", "x = !y"}) {
+    int failed_at = -1;
+    const auto tokens = ScanAll(text, &failed_at);
+
+    EXPECT_EQ(failed_at, text.find_first_of("@!")) << text;
+    EXPECT_TRUE(SameTokens(tokens, eager.Tokenize(text.substr(0, failed_at))))
+        << text;
+    EXPECT_THROW(eager.Tokenize(text), ParserInternalError) << text;
+    EXPECT_THROW(direct.Tokenize(text), ParserInternalError) << text;
+  }
+}
+
+TEST(DirectScanner, Parse) {
+  // CreateParser sets ParserOptions::scanner
+  auto parser = CreateParser();
+  ASSERT_EQ(parser->Compiled()->ActiveLexerMode(), LexerMode::Direct);
+
+  const std::string text = kLangSample;
+  Arena arena;
+  auto* unit = parser->Parse(arena, text);
+
+  ASSERT_EQ(FunctionNames(unit, text),
+            (std::vector<std::string>{"add", "mul", "main"}));
+
+  // return x+y;
+  const auto* add = unit->functions()->Value()[0];
+  ASSERT_EQ(add->params()->Size(), 2);
+  ASSERT_EQ(add->body()->Size(), 1);
+
+  auto* ret = dynamic_cast<ReturnStmt*>(add->body()->Value()[0]);
+  ASSERT_NE(ret, nullptr);
+  auto* sum = dynamic_cast<BinaryExpr*>(ret->expr());
+  ASSERT_NE(sum, nullptr);
+  EXPECT_EQ(sum->op().Value(), BinaryOp::Plus);
+
+  auto* lhs = dynamic_cast<NamedExpr*>(sum->lhs());
+  ASSERT_NE(lhs, nullptr);
+  EXPECT_EQ(text.substr(lhs->id().Offset(), lhs->id().Length()), "x");
+
+  Arena failed_arena;
+  EXPECT_THROW(parser->Parse(failed_arena, "func f() -> int { return @; }"),
+               ParserInternalError);
+}
+
+}  // namespace
+}  // namespace RG::Test
@@ -0,0 +1,187 @@
+#ifndef REGGEN_UNITTESTS_PARSER_EXPR_GRAMMAR_H
+#define REGGEN_UNITTESTS_PARSER_EXPR_GRAMMAR_H
+
+#include <string>
+#include <string_view>
+
+#include "RegGen/RegGenInclude.h"
+
+// arithmetic expressions shared by parser tests
+namespace RG::Test {
+
+inline const char* const kExprConfig = R"##(
+token num = "[0-9]+";
+token plus = "\+";
+token star = "\*";
+token lp = "\(";
+token rp = "\)";
+
+ignore ws = "[ ]+";
+
+enum ExprOp { Add; Mul; }
+
+base Expr;
+
+node NumExpr : Expr
+{
+    token value;
+}
+node BinExpr : Expr
+{
+    ExprOp op;
+    Expr lhs;
+    Expr rhs;
+}
+
+rule AddOp : ExprOp
+    = plus -> Add
+    ;
+rule MulOp : ExprOp
+    = star -> Mul
+    ;
+
+rule Factor : Expr
+    = num:value -> NumExpr
+    = lp Sum! rp
+    ;
+rule Term : Expr
+    = Term:lhs MulOp:op Factor:rhs -> BinExpr
+    = Factor!
+    ;
+rule Sum : Expr
+    = Sum:lhs AddOp:op Term:rhs -> BinExpr
+    = Term!
+    ;
+)##";
+
+// a single ambiguous rule, disambiguated by precedence declarations
+inline const char* const kPrecedenceExprConfig = R"##(
+token num = "[0-9]+";
+token plus = "\+";
+token minus = "-";
+token star = "\*";
+token caret = "\^";
+token eq = "==";
+token lp = "\(";
+token rp = "\)";
+
+ignore ws = "[ ]+";
+
+%nonassoc eq;
+%left plus minus;
+%left star;
+%right caret;
+
+enum ExprOp { Add; Mul; Sub; Pow; Eq; }
+
+base Expr;
+
+node NumExpr : Expr
+{
+    token value;
+}
+node BinExpr : Expr
+{
+    ExprOp op;
+    Expr lhs;
+    Expr rhs;
+}
+
+rule AddOp : ExprOp = plus -> Add;
+rule SubOp : ExprOp = minus -> Sub;
+rule MulOp : ExprOp = star -> Mul;
+rule PowOp : ExprOp = caret -> Pow;
+rule EqOp : ExprOp = eq -> Eq;
+
+rule Arith : Expr
+    = Arith:lhs AddOp:op Arith:rhs %prec plus -> BinExpr
+    = Arith:lhs SubOp:op Arith:rhs %prec minus -> BinExpr
+    = Arith:lhs MulOp:op Arith:rhs %prec star -> BinExpr
+    = Arith:lhs PowOp:op Arith:rhs %prec caret -> BinExpr
+    = Arith:lhs EqOp:op Arith:rhs %prec eq -> BinExpr
+    = num:value -> NumExpr
+    = lp Arith! rp
+    ;
+)##";
+
+enum ExprOp : int {
+  Add,
+  Mul,
+  Sub,
+  Pow,
+  Eq,
+};
+
+class Expr : public AST::BasicASTObject {
+ public:
+  virtual auto Evaluate(std::string_view text) const -> int = 0;
+};
+
+class NumExpr : public Expr, public AST::DataBundle<AST::BasicASTToken> {
+ public:
+  auto value() const -> const auto& { return GetItem<0>(); }
+
+  auto Evaluate(std::string_view text) const -> int override {
+    return std::stoi(std::string{text.substr(value().Offset(),
+                                             value().Length())});
+  }
+};
+
+class BinExpr : public Expr,
+                public AST::DataBundle<AST::BasicASTEnum<ExprOp>, Expr*,
+                                       Expr*> {
+ public:
+  auto op() const -> const auto& { return GetItem<0>(); }
+  auto lhs() const -> const auto& { return GetItem<1>(); }
+  auto rhs() const -> const auto& { return GetItem<2>(); }
+
+  auto Evaluate(std::string_view text) const -> int override {
+    auto x = lhs()->Evaluate(text);
+    auto y = rhs()->Evaluate(text);
+
+    switch (op().Value()) {
+      case ExprOp::Add:
+        return x + y;
+      case ExprOp::Mul:
+        return x * y;
+      case ExprOp::Sub:
+        return x - y;
+      case ExprOp::Pow: {
+        auto result = 1;
+        for (int i = 0; i < y; ++i) {
+          result *= x;
+        }
+        return result;
+      }
+      case ExprOp::Eq:
+        return x == y;
+    }
+
+    return 0;
+  }
+};
+
+inline auto ExprProxyManager() -> const AST::ASTTypeProxyManager& {
+  static const auto env = []() {
+    AST::ASTTypeProxyManager env;
+    env.RegisterEnum<ExprOp>("ExprOp");
+    env.RegisterClass<Expr>("Expr");
+    env.RegisterClass<NumExpr>("NumExpr");
+    env.RegisterClass<BinExpr>("BinExpr");
+
+    return env;
+  }();
+
+  return env;
+}
+
+inline auto Evaluate(GenericParser& parser, const std::string& text) -> int {
+  Arena arena;
+  auto result = parser.Parse(arena, text);
+
+  return result.Extract<Expr*>()->Evaluate(text);
+}
+
+}  // namespace RG::Test
+
+#endif  // REGGEN_UNITTESTS_PARSER_EXPR_GRAMMAR_H
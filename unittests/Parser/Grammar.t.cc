@@ -0,0 +1,113 @@
+#include "RegGen/Parser/Grammar.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "RegGen/Parser/MetaInfo.h"
+
+namespace RG::Test {
+namespace {
+
+// Cs may vanish, so whatever follows it also follows Bs
+constexpr const char* kNullableConfig = R"##(
+token a = "a";
+token b = "b";
+token c = "c";
+token d = "d";
+
+node Node
+{
+    token x;
+}
+
+rule B : Node = b:x -> _;
+rule C : Node = c:x -> _;
+
+rule Bs : Node'vec
+    = -> _
+    = Bs! B&
+    ;
+rule Cs : Node'vec
+    = -> _
+    = Cs! C&
+    ;
+
+rule S : Node
+    = a:x Bs Cs d -> _
+    = Bs Cs -> _
+    ;
+)##";
+
+// the plain grammar, every symbol unversioned
+auto BuildGrammar(const MetaInfo& info) -> std::unique_ptr<Grammar> {
+  GrammarBuilder builder;
+
+  for (const auto& production : info.Productions()) {
+    auto* lhs = builder.MakeNonterminal(production.Left(), nullptr);
+
+    SymbolVec rhs;
+    for (const auto* s : production.Right()) {
+      rhs.push_back(builder.MakeGenericSymbol(s, nullptr));
+    }
+    builder.CreateProduction(&production, lhs, rhs);
+  }
+
+  return builder.Build(builder.MakeNonterminal(&info.RootVariable(), nullptr));
+}
+
+auto Names(const Grammar& g, const TerminalSet& terms)
+    -> std::set<std::string> {
+  std::set<std::string> result;
+  terms.for_each(
+      [&](int id) { result.insert(g.LookupTerminal(id)->Info()->Name()); });
+
+  return result;
+}
+
+TEST(Grammar, PredicativeSets) {
+  auto info = ResolveParserInfo(kNullableConfig, nullptr);
+  auto g = BuildGrammar(*info);
+
+  auto lookup = [&](const char* name) {
+    return g->LookupNonterminal(
+        {info->LookupSymbol(name)->AsVariable(), nullptr});
+  };
+  const auto* bs = lookup("Bs");
+  const auto* cs = lookup("Cs");
+  const auto* s = lookup("S");
+
+  EXPECT_TRUE(bs->MayProduceEpsilon());
+  EXPECT_TRUE(cs->MayProduceEpsilon());
+  EXPECT_TRUE(s->MayProduceEpsilon());
+
+  using Set = std::set<std::string>;
+  EXPECT_EQ(Names(*g, bs->FirstSet()), (Set{"b"}));
+  EXPECT_EQ(Names(*g, cs->FirstSet()), (Set{"c"}));
+  EXPECT_EQ(Names(*g, s->FirstSet()), (Set{"a", "b", "c"}));
+
+  EXPECT_EQ(Names(*g, bs->FollowSet()), (Set{"b", "c", "d"}));
+  EXPECT_EQ(Names(*g, cs->FollowSet()), (Set{"c", "d"}));
+
+  // S is the root, and Bs Cs may end it
+  EXPECT_TRUE(s->MayPreceedEof());
+  EXPECT_TRUE(bs->MayPreceedEof());
+  EXPECT_TRUE(cs->MayPreceedEof());
+}
+
+TEST(Grammar, DenseSymbolIds) {
+  auto info = ResolveParserInfo(kNullableConfig, nullptr);
+  auto g = BuildGrammar(*info);
+
+  ASSERT_EQ(g->Terminals().size(), 4);
+  for (const auto& [key, term] : g->Terminals()) {
+    EXPECT_EQ(g->LookupTerminal(term.Id()), &term);
+  }
+  for (const auto& [key, var] : g->Nonterminals()) {
+    EXPECT_EQ(g->LookupNonterminal(var.Id()), &var);
+  }
+}
+
+}  // namespace
+}  // namespace RG::Test
@@ -0,0 +1,79 @@
+#ifndef REGGEN_UNITTESTS_PARSER_LANG_GRAMMAR_H
+#define REGGEN_UNITTESTS_PARSER_LANG_GRAMMAR_H
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// generated by BootstrapParser from lang_define.txt
+#include "Header.h"
+
+// the sample language of the driver, with its generated scanner and ast
+namespace RG::Test {
+
+inline auto LangConfig() -> const std::string& {
+  static const auto config = [] {
+    std::ifstream file{REGGEN_SOURCE_DIR "/lang_define.txt"};
+    return std::string(std::istreambuf_iterator<char>{file}, {});
+  }();
+
+  return config;
+}
+
+inline const char* const kLangSample =
+    "func add(x: int, y: int) -> int { return x+y; }\n"
+    "func mul(x: int, y: int) -> int { return x*y; }\n"
+    "func main() -> unit { if(true) while(true) if(true) {} else {} else val "
+    "x:int=41; }\n";
+
+inline auto LangProxyManager() -> const AST::ASTTypeProxyManager& {
+  static const auto env = [] {
+    AST::ASTTypeProxyManager env;
+
+    env.RegisterEnum<BoolValue>("BoolValue");
+    env.RegisterEnum<BinaryOp>("BinaryOp");
+    env.RegisterEnum<JumpCommand>("JumpCommand");
+    env.RegisterEnum<VariableMutability>("VariableMutability");
+
+    env.RegisterClass<Literal>("Literal");
+    env.RegisterClass<Type>("Type");
+    env.RegisterClass<Expression>("Expression");
+    env.RegisterClass<Statement>("Statement");
+
+    env.RegisterClass<BoolLiteral>("BoolLiteral");
+    env.RegisterClass<IntLiteral>("IntLiteral");
+    env.RegisterClass<NamedType>("NamedType");
+    env.RegisterClass<BinaryExpr>("BinaryExpr");
+    env.RegisterClass<NamedExpr>("NamedExpr");
+    env.RegisterClass<LiteralExpr>("LiteralExpr");
+    env.RegisterClass<VariableDeclStmt>("VariableDeclStmt");
+    env.RegisterClass<JumpStmt>("JumpStmt");
+    env.RegisterClass<ReturnStmt>("ReturnStmt");
+    env.RegisterClass<CompoundStmt>("CompoundStmt");
+    env.RegisterClass<WhileStmt>("WhileStmt");
+    env.RegisterClass<ChoiceStmt>("ChoiceStmt");
+    env.RegisterClass<TypedName>("TypedName");
+    env.RegisterClass<FuncDecl>("FuncDecl");
+    env.RegisterClass<TranslationUnit>("TranslationUnit");
+
+    return env;
+  }();
+
+  return env;
+}
+
+// names of the functions of a translation unit parsed from text
+inline auto FunctionNames(TranslationUnit* unit, const std::string& text)
+    -> std::vector<std::string> {
+  std::vector<std::string> result;
+  for (const auto* func : unit->functions()->Value()) {
+    result.push_back(text.substr(func->name().Offset(), func->name().Length()));
+  }
+
+  return result;
+}
+
+}  // namespace RG::Test
+
+#endif  // REGGEN_UNITTESTS_PARSER_LANG_GRAMMAR_H
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <variant>
+
+#include "ExprGrammar.h"
+#include "RegGen/Parser/MetaInfo.h"
+#include "RegGen/Parser/ParserAutomaton.h"
+
+namespace RG::Test {
+namespace {
+
+auto BuildAutomaton(const MetaInfo& info, LookaheadAlgorithm algorithm)
+    -> std::unique_ptr<const ParserAutomaton> {
+  LALROptions options;
+  options.lookahead = algorithm;
+
+  return BuildLALRAutomaton(info, options);
+}
+
+auto SameEdge(const PdaEdge& lhs, const PdaEdge& rhs) -> bool {
+  if (lhs.index() != rhs.index()) {
+    return false;
+  } else if (const auto* shift = std::get_if<PdaEdgeShift>(&lhs); shift) {
+    return shift->target->Id() == std::get<PdaEdgeShift>(rhs).target->Id();
+  } else if (const auto* reduce = std::get_if<PdaEdgeReduce>(&lhs); reduce) {
+    return reduce->production == std::get<PdaEdgeReduce>(rhs).production;
+  }
+
+  return true;
+}
+
+// both algorithms must produce exactly the same tables
+auto ExpectSameLookaheads(const std::string& config) -> void {
+  auto info = ResolveParserInfo(config, nullptr);
+
+  auto expected = BuildAutomaton(*info, LookaheadAlgorithm::ExtendedGrammar);
+  auto actual = BuildAutomaton(*info, LookaheadAlgorithm::Relations);
+  ASSERT_EQ(actual->StateCount(), expected->StateCount());
+
+  for (int id = 0; id < expected->StateCount(); ++id) {
+    const auto* lhs = expected->LookupState(id);
+    const auto* rhs = actual->LookupState(id);
+
+    ASSERT_EQ(lhs->EofAction().has_value(), rhs->EofAction().has_value())
+        << "state " << id;
+    if (lhs->EofAction()) {
+      EXPECT_EQ(lhs->EofAction()->production, rhs->EofAction()->production)
+          << "state " << id;
+    }
+
+    ASSERT_EQ(lhs->ActionMap().size(), rhs->ActionMap().size())
+        << "state " << id;
+    for (const auto& [tok, edge] : lhs->ActionMap()) {
+      auto it = rhs->ActionMap().find(tok);
+      ASSERT_NE(it, rhs->ActionMap().end()) << "state " << id;
+      EXPECT_TRUE(SameEdge(edge, it->second))
+          << "state " << id << " on " << tok->Name();
+    }
+  }
+}
+
+TEST(Lookahead, SameAsExtendedGrammar) {
+  ExpectSameLookaheads(kExprConfig);
+  ExpectSameLookaheads(kPrecedenceExprConfig);
+
+  std::ifstream file{REGGEN_SOURCE_DIR "/lang_define.txt"};
+  ASSERT_TRUE(file.good());
+  ExpectSameLookaheads(
+      std::string(std::istreambuf_iterator<char>{file}, {}));
+}
+
+// epsilon productions are not handled by the extended grammar, so this one
+// is checked by hand
+constexpr const char* kNullableConfig = R"##(
+token a = "a";
+token b = "b";
+token c = "c";
+
+node Node
+{
+    token x;
+}
+
+rule B : Node = b:x -> _;
+rule C : Node = c:x -> _;
+
+rule Bs : Node'vec
+    = -> _
+    = Bs! B&
+    ;
+rule Cs : Node'vec
+    = -> _
+    = Cs! C&
+    ;
+
+rule S : Node
+    = a:x Bs Cs -> _
+    ;
+)##";
+
+TEST(Lookahead, NullableVariables) {
+  auto info = ResolveParserInfo(kNullableConfig, nullptr);
+  auto pda = BuildLALRAutomaton(*info);
+
+  const auto& tokens = info->Tokens();
+  const auto& empty_bs = info->LookupSymbol("Bs")->AsVariable()->Productions();
+  const auto& empty_cs = info->LookupSymbol("Cs")->AsVariable()->Productions();
+
+  auto shift = [&](const ParserState* state, const SymbolInfo* s) {
+    if (const auto* tok = s->AsToken(); tok) {
+      return std::get<PdaEdgeShift>(state->ActionMap().at(tok)).target;
+    }
+    return state->GotoMap().at(s->AsVariable());
+  };
+  auto expect_reduce = [&](const ParserState* state, const TokenInfo* tok,
+                           const ProductionInfo* production) {
+    auto it = state->ActionMap().find(tok);
+    ASSERT_NE(it, state->ActionMap().end()) << tok->Name();
+    EXPECT_EQ(std::get<PdaEdgeReduce>(it->second).production, production)
+        << tok->Name();
+  };
+
+  // after a, Bs -> . is followed by b from Bs, and by c or eof through the
+  // nullable Cs
+  const auto* after_a = shift(pda->LookupState(0), &tokens[0]);
+  expect_reduce(after_a, &tokens[1], empty_bs[0]);
+  expect_reduce(after_a, &tokens[2], empty_bs[0]);
+  ASSERT_TRUE(after_a->EofAction());
+  EXPECT_EQ(after_a->EofAction()->production, empty_bs[0]);
+
+  // after a Bs, b is shifted and Cs -> . is followed by c or eof
+  const auto* after_bs = shift(after_a, info->LookupSymbol("Bs"));
+  EXPECT_TRUE(std::holds_alternative<PdaEdgeShift>(
+      after_bs->ActionMap().at(&tokens[1])));
+  expect_reduce(after_bs, &tokens[2], empty_cs[0]);
+  ASSERT_TRUE(after_bs->EofAction());
+  EXPECT_EQ(after_bs->EofAction()->production, empty_cs[0]);
+}
+
+}  // namespace
+}  // namespace RG::Test
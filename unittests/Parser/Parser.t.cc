@@ -0,0 +1,253 @@
+#include "RegGen/Parser/Parser.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ExprGrammar.h"
+#include "RegGen/Common/ThreadPool.h"
+
+namespace RG::Test {
+namespace {
+
+TEST(Parser, Evaluate) {
+  GenericParser parser{kExprConfig, &ExprProxyManager()};
+
+  EXPECT_EQ(Evaluate(parser, "42"), 42);
+  EXPECT_EQ(Evaluate(parser, "1 + 2 * 3"), 7);
+  EXPECT_EQ(Evaluate(parser, "(1 + 2) * 3"), 9);
+  EXPECT_EQ(Evaluate(parser, "2 * 3 * 4 + 5 + 6"), 35);
+  EXPECT_EQ(Evaluate(parser, "((((7))))"), 7);
+}
+
+TEST(Parser, RejectInvalidInput) {
+  GenericParser parser{kExprConfig, &ExprProxyManager()};
+
+  // default reductions may run first, but nothing wrong is ever accepted
+  for (const auto* text : {"", "1 +", "1 2", "(1", "1)", "* 2", "1 + + 2"}) {
+    Arena arena;
+    EXPECT_THROW(parser.Parse(arena, text), ParserInternalError) << text;
+  }
+
+  Arena arena;
+  EXPECT_THROW(parser.Parse(arena, "1 ? 2"), ParserInternalError);
+}
+
+TEST(Parser, EliminateUnitProductions) {
+  GenericParser parser{kExprConfig, &ExprProxyManager()};
+
+  ParserOptions options;
+  options.eliminate_unit_productions = true;
+  GenericParser bypassing{kExprConfig, &ExprProxyManager(), options};
+
+  for (const auto* text : {"42", "1 + 2 * 3", "(1 + 2) * 3", "((((7))))"}) {
+    EXPECT_EQ(Evaluate(bypassing, text), Evaluate(parser, text)) << text;
+  }
+
+  // the skipped reductions would not have changed any location
+  Arena arena;
+  auto* expr = bypassing.Parse(arena, "  (1 + 2) * 3").Extract<Expr*>();
+  EXPECT_EQ(expr->Offset(), 2);
+  EXPECT_EQ(expr->Length(), 11);
+
+  for (const auto* text : {"", "1 +", "1 2", "(1", "1)", "* 2"}) {
+    EXPECT_THROW(bypassing.Parse(arena, text), ParserInternalError) << text;
+  }
+}
+
+TEST(Parser, ParallelConstruction) {
+  const auto& env = ExprProxyManager();
+
+  for (const auto* config : {kExprConfig, kPrecedenceExprConfig}) {
+    auto expected = GenericParser{config, &env}.SerializeTables();
+
+    for (auto thread_num : {1, 2, 4}) {
+      ThreadPool pool{thread_num};
+
+      ParserOptions options;
+      options.thread_pool = &pool;
+      GenericParser parser{config, &env, options};
+
+      EXPECT_EQ(parser.SerializeTables(), expected) << thread_num;
+    }
+  }
+}
+
+TEST(Parser, ConcurrentConstruction) {
+  const auto& env = ExprProxyManager();
+
+  ParserOptions sequential_options;
+  sequential_options.concurrent_construction = false;
+  GenericParser sequential{kPrecedenceExprConfig, &env, sequential_options};
+
+  ThreadPool pool{2};
+  ParserOptions pool_options;
+  pool_options.thread_pool = &pool;
+
+  const auto expected = sequential.SerializeTables();
+  for (const auto& options : {ParserOptions{}, pool_options}) {
+    GenericParser parser{kPrecedenceExprConfig, &env, options};
+    EXPECT_EQ(parser.SerializeTables(), expected);
+    EXPECT_EQ(Evaluate(parser, "1 + 2 * 3 ^ 2"), 19);
+
+    // each branch runs within the total after resolving
+    const auto& timings = parser.Timings();
+    EXPECT_GT(timings.total_ms, 0);
+    EXPECT_GE(timings.total_ms,
+              timings.resolve_ms + timings.lexer_automaton_ms +
+                  timings.lexing_table_ms);
+    EXPECT_GE(timings.total_ms,
+              timings.resolve_ms + timings.parser_automaton_ms +
+                  timings.parsing_table_ms);
+  }
+
+  const auto& timings = sequential.Timings();
+  EXPECT_GE(timings.total_ms,
+            timings.resolve_ms + timings.lexer_automaton_ms +
+                timings.lexing_table_ms + timings.parser_automaton_ms +
+                timings.parsing_table_ms);
+}
+
+TEST(Parser, InvalidOptions) {
+  ParserOptions options;
+  options.lexer_mode = LexerMode::Lazy;
+
+  for (auto capacity : {-1, 0, 1}) {
+    options.lazy_cache_capacity = capacity;
+    EXPECT_THROW(
+        (GenericParser{kPrecedenceExprConfig, &ExprProxyManager(), options}),
+        ParserConstructionError)
+        << capacity;
+  }
+
+  options.lazy_cache_capacity = 2;
+  GenericParser parser{kPrecedenceExprConfig, &ExprProxyManager(), options};
+  EXPECT_EQ(Evaluate(parser, "1 + 2 * 3"), 7);
+}
+
+TEST(Parser, SharedGrammar) {
+  constexpr int kThreadNum = 4;
+  constexpr int kRound = 200;
+
+  for (auto mode : {LexerMode::Eager, LexerMode::Lazy, LexerMode::Nfa}) {
+    ParserOptions options;
+    options.lexer_mode = mode;
+
+    // a tiny cache keeps the lazy dfa of every thread flushing
+    options.lazy_cache_capacity = 4;
+
+    const auto grammar = std::make_shared<const CompiledGrammar>(
+        kPrecedenceExprConfig, &ExprProxyManager(), options);
+
+    std::vector<int> failures(kThreadNum, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreadNum; ++i) {
+      threads.emplace_back([&, i] {
+        // half of them through parsers sharing the grammar
+        GenericParser parser{grammar};
+
+        for (int round = 0; round < kRound; ++round) {
+          auto text = std::to_string(i) + " + " + std::to_string(round) +
+                      " * 2 ^ 2";
+
+          Arena arena;
+          auto result = i % 2 == 0 ? grammar->Parse(arena, text)
+                                   : parser.Parse(arena, text);
+          if (result.Extract<Expr*>()->Evaluate(text) != i + round * 4) {
+            failures[i] += 1;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (auto failure : failures) {
+      EXPECT_EQ(failure, 0);
+    }
+  }
+}
+
+TEST(Parser, ParseBatch) {
+  const CompiledGrammar grammar{kPrecedenceExprConfig, &ExprProxyManager()};
+
+  // every tenth input is broken
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 1000; ++i) {
+    inputs.push_back(i % 10 == 9 ? std::to_string(i) + " +"
+                                 : std::to_string(i) + " * 2 + 1");
+  }
+
+  auto check = [&](BatchParseResult result) {
+    ASSERT_EQ(result.Size(), inputs.size());
+    EXPECT_EQ(result.FailureCount(), 100);
+
+    for (int i = 0; i < inputs.size(); ++i) {
+      auto& outcome = result[i];
+      if (i % 10 == 9) {
+        ASSERT_FALSE(outcome.Succeeded()) << i;
+        EXPECT_THROW(std::rethrow_exception(outcome.error),
+                     ParserInternalError);
+      } else {
+        ASSERT_TRUE(outcome.Succeeded()) << i;
+        EXPECT_EQ(outcome.value.Extract<Expr*>()->Evaluate(inputs[i]),
+                  i * 2 + 1);
+      }
+    }
+  };
+
+  check(grammar.ParseBatch(inputs));
+  for (auto thread_num : {1, 4}) {
+    ThreadPool pool{thread_num};
+    check(grammar.ParseBatch(inputs, &pool));
+  }
+
+  EXPECT_EQ(grammar.ParseBatch(ArrayRef<std::string>{}).Size(), 0);
+
+  // views into the inputs, through a parser handle
+  const std::vector<std::string_view> views(inputs.begin(), inputs.end());
+  const GenericParser parser{kPrecedenceExprConfig, &ExprProxyManager()};
+  check(parser.ParseBatch(views));
+}
+
+TEST(Parser, Pipelined) {
+  // enough tokens for the ring to fill up many times over
+  std::string text = "1";
+  for (int i = 0; i < 30000; ++i) {
+    text += i % 2 == 0 ? " + 2" : " * 3";
+  }
+  const auto expected = 1 + 15000 * 2 * 3;
+
+  for (auto mode : {LexerMode::Eager, LexerMode::Lazy, LexerMode::Nfa}) {
+    ParserOptions options;
+    options.lexer_mode = mode;
+    options.pipeline_threshold = 64;
+    GenericParser parser{kPrecedenceExprConfig, &ExprProxyManager(), options};
+
+    EXPECT_EQ(Evaluate(parser, text), expected);
+
+    // short inputs are parsed on the calling thread
+    EXPECT_EQ(Evaluate(parser, "1 + 2"), 3);
+
+    // a token that does not match, or a parsing error, in the middle
+    auto invalid = text;
+    invalid[text.size() / 2] = '?';
+    auto unexpected = text;
+    unexpected[text.size() / 2 - 1] = '+';
+    unexpected[text.size() / 2] = '+';
+
+    Arena arena;
+    EXPECT_THROW(parser.Parse(arena, invalid), ParserInternalError);
+    EXPECT_THROW(parser.Parse(arena, unexpected), ParserInternalError);
+
+    // and it still works afterwards
+    EXPECT_EQ(Evaluate(parser, text), expected);
+  }
+}
+
+}  // namespace
+}  // namespace RG::Test
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "ExprGrammar.h"
+#include "RegGen/Common/ThreadPool.h"
+#include "RegGen/Parser/MetaInfo.h"
+#include "RegGen/Parser/ParserAutomaton.h"
+
+namespace RG::Test {
+namespace {
+
+TEST(ParserAutomaton, InternKernels) {
+  auto info = ResolveParserInfo(kExprConfig, nullptr);
+  const auto* production = &info->Productions().front();
+  const auto initial = ItemSet{ParserItem{production, 0}};
+  const auto advanced = ItemSet{ParserItem{production, 1}};
+
+  ParserAutomaton pda;
+
+  auto [first, first_inserted] = pda.MakeState(initial);
+  auto [second, second_inserted] = pda.MakeState(advanced);
+  auto [again, again_inserted] = pda.MakeState(initial);
+
+  EXPECT_TRUE(first_inserted);
+  EXPECT_TRUE(second_inserted);
+  EXPECT_FALSE(again_inserted);
+
+  EXPECT_EQ(again, first);
+  EXPECT_EQ(first->Id(), 0);
+  EXPECT_EQ(second->Id(), 1);
+  EXPECT_EQ(pda.StateCount(), 2);
+  EXPECT_EQ(pda.LookupKernel(1), advanced);
+}
+
+TEST(ParserAutomaton, DistinctKernels) {
+  auto info = ResolveParserInfo(kPrecedenceExprConfig, nullptr);
+  auto pda = BuildLALRAutomaton(*info);
+
+  for (int id = 0; id < pda->StateCount(); ++id) {
+    EXPECT_EQ(pda->LookupState(id)->Id(), id);
+
+    // only the initial state has items of cursor 0
+    for (const auto& item : pda->LookupKernel(id)) {
+      EXPECT_EQ(item.IsKernel(), id != 0);
+    }
+    for (int other = 0; other < id; ++other) {
+      EXPECT_NE(pda->LookupKernel(id), pda->LookupKernel(other));
+    }
+  }
+}
+
+TEST(ParserAutomaton, ParallelConstruction) {
+  std::ifstream file{REGGEN_SOURCE_DIR "/lang_define.txt"};
+  ASSERT_TRUE(file.good());
+
+  auto info = ResolveParserInfo(
+      std::string(std::istreambuf_iterator<char>{file}, {}), nullptr);
+  auto expected = BuildLALRAutomaton(*info);
+
+  for (auto thread_num : {1, 2, 4}) {
+    ThreadPool pool{thread_num};
+
+    LALROptions options;
+    options.thread_pool = &pool;
+    auto pda = BuildLALRAutomaton(*info, options);
+
+    // same kernel under the same id, with the same edges
+    ASSERT_EQ(pda->StateCount(), expected->StateCount());
+    for (int id = 0; id < pda->StateCount(); ++id) {
+      EXPECT_EQ(pda->LookupKernel(id), expected->LookupKernel(id));
+
+      const auto& gotos = pda->LookupState(id)->GotoMap();
+      const auto& expected_gotos = expected->LookupState(id)->GotoMap();
+      ASSERT_EQ(gotos.size(), expected_gotos.size());
+      for (const auto& [var, target] : gotos) {
+        EXPECT_EQ(target->Id(), expected_gotos.at(var)->Id());
+      }
+
+      EXPECT_EQ(pda->LookupState(id)->ActionMap().size(),
+                expected->LookupState(id)->ActionMap().size());
+    }
+  }
+}
+
+}  // namespace
+}  // namespace RG::Test
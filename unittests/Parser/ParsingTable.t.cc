@@ -0,0 +1,82 @@
+#include "RegGen/Parser/ParsingTable.h"
+
+#include <gtest/gtest.h>
+
+#include "RegGen/Common/BinaryStream.h"
+#include "RegGen/Container/SmallVector.h"
+
+namespace RG::Test {
+namespace {
+
+constexpr int kRowNum = 5;
+constexpr int kColumnNum = 6;
+
+// row-major, 0 is the default of every row but the last one
+constexpr int32_t kDenseTable[kRowNum * kColumnNum] = {
+    0, 3, 0, 0, 7, 0,  //
+    1, 2, 3, 4, 5, 6,  //
+    0, 0, 0, 0, 0, 0,  //
+    9, 0, 0, 9, 0, 0,  //
+    4, 4, 4, 8, 4, 4,  //
+};
+constexpr int32_t kDefaults[kRowNum] = {0, 0, 0, 0, 4};
+
+auto CompressExample() -> RowDisplacementTable {
+  return RowDisplacementTable::Compress(
+      ArrayRef<int32_t>{kDenseTable, kRowNum * kColumnNum}, kColumnNum,
+      ArrayRef<int32_t>{kDefaults, kRowNum});
+}
+
+auto ExpectSameAsDense(const RowDisplacementTable& table) -> void {
+  ASSERT_EQ(table.RowCount(), kRowNum);
+  ASSERT_EQ(table.ColumnCount(), kColumnNum);
+
+  for (int row = 0; row < kRowNum; ++row) {
+    for (int col = 0; col < kColumnNum; ++col) {
+      EXPECT_EQ(table.Lookup(row, col), kDenseTable[row * kColumnNum + col])
+          << row << ", " << col;
+    }
+  }
+}
+
+TEST(ParsingTable, Lookup) {
+  auto table = CompressExample();
+  ExpectSameAsDense(table);
+
+  // 11 non-default entries overlaid in at most the dense size
+  EXPECT_GE(table.SlotCount(), 11);
+  EXPECT_LT(table.SlotCount(), kRowNum * kColumnNum);
+}
+
+TEST(ParsingTable, ForEachValue) {
+  SmallVector<int32_t> values;
+  CompressExample().ForEachValue(
+      [&](int32_t value) { values.push_back(value); });
+
+  // defaults of all rows followed by the stored entries
+  EXPECT_EQ(values.size(), kRowNum + 11);
+}
+
+TEST(ParsingTable, SerializeRoundTrip) {
+  BinaryWriter writer;
+  CompressExample().Serialize(writer);
+
+  BinaryReader reader{writer.Buffer()};
+  auto table = RowDisplacementTable::Deserialize(reader, kRowNum, kColumnNum);
+  EXPECT_TRUE(reader.Exhausted());
+
+  ExpectSameAsDense(table);
+}
+
+TEST(ParsingTable, RejectWrongShape) {
+  BinaryWriter writer;
+  CompressExample().Serialize(writer);
+
+  BinaryReader reader{writer.Buffer()};
+  EXPECT_THROW(
+      RowDisplacementTable::Deserialize(reader, kRowNum, kColumnNum + 1),
+      ParserConstructionError);
+}
+
+}  // namespace
+}  // namespace RG::Test
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "ExprGrammar.h"
+#include "RegGen/Parser/Parser.h"
+
+namespace RG::Test {
+namespace {
+
+TEST(Precedence, ResolveConflicts) {
+  GenericParser parser{kPrecedenceExprConfig, &ExprProxyManager()};
+
+  EXPECT_EQ(Evaluate(parser, "1 + 2 * 3"), 7);
+  EXPECT_EQ(Evaluate(parser, "2 * 3 + 1"), 7);
+  EXPECT_EQ(Evaluate(parser, "(1 + 2) * 3"), 9);
+
+  // left associative
+  EXPECT_EQ(Evaluate(parser, "10 - 3 - 2"), 5);
+  EXPECT_EQ(Evaluate(parser, "10 - 3 + 2"), 9);
+
+  // right associative, binding tighter than star
+  EXPECT_EQ(Evaluate(parser, "2 ^ 3 ^ 2"), 512);
+  EXPECT_EQ(Evaluate(parser, "3 * 2 ^ 2"), 12);
+
+  // binding looser than everything else
+  EXPECT_EQ(Evaluate(parser, "1 + 2 == 3"), 1);
+  EXPECT_EQ(Evaluate(parser, "2 * 2 == 3"), 0);
+}
+
+TEST(Precedence, NonAssociative) {
+  GenericParser parser{kPrecedenceExprConfig, &ExprProxyManager()};
+
+  Arena arena;
+  EXPECT_THROW(parser.Parse(arena, "1 == 1 == 1"), ParserInternalError);
+  EXPECT_EQ(Evaluate(parser, "(1 == 1) == 1"), 1);
+}
+
+TEST(Precedence, RejectUnresolvedConflict) {
+  const auto& env = ExprProxyManager();
+
+  // drop the declarations that resolve the ambiguity
+  auto config = std::string{kPrecedenceExprConfig};
+  auto begin = config.find("%nonassoc");
+  auto end = config.find("enum");
+  auto ambiguous = config.substr(0, begin) + config.substr(end);
+
+  EXPECT_THROW((GenericParser{ambiguous, &env}), ParserConstructionError);
+
+  // only some operators are declared
+  auto partial = config;
+  partial.replace(partial.find("%left star;"), 11, "");
+
+  EXPECT_THROW((GenericParser{partial, &env}), ParserConstructionError);
+}
+
+TEST(Precedence, RejectUnknownToken) {
+  const auto& env = ExprProxyManager();
+
+  auto config = std::string{kPrecedenceExprConfig};
+  config.replace(config.find("%right caret;"), 13, "%right hat;");
+
+  EXPECT_THROW((GenericParser{config, &env}), ParserConstructionError);
+}
+
+}  // namespace
+}  // namespace RG::Test
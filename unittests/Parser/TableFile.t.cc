@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "ExprGrammar.h"
+#include "LangGrammar.h"
+#include "RegGen/Parser/Parser.h"
+
+namespace RG::Test {
+namespace {
+
+// empty productions are written and loaded like any other
+constexpr const char* kNullableConfig = R"##(
+token a = "a";
+token b = "b";
+token c = "c";
+
+node Node
+{
+    token x;
+}
+
+rule B : Node = b:x -> _;
+rule C : Node = c:x -> _;
+
+rule Bs : Node'vec
+    = -> _
+    = Bs! B&
+    ;
+rule Cs : Node'vec
+    = -> _
+    = Cs! C&
+    ;
+
+rule S : Node
+    = a:x Bs Cs -> _
+    ;
+)##";
+
+class Node : public AST::BasicASTObject,
+             public AST::DataBundle<AST::BasicASTToken> {};
+
+auto NullableEnv() -> const AST::ASTTypeProxyManager& {
+  static const auto env = [] {
+    AST::ASTTypeProxyManager env;
+    env.RegisterClass<Node>("Node");
+
+    return env;
+  }();
+
+  return env;
+}
+
+TEST(TableFile, RoundTrip) {
+  const auto& env = ExprProxyManager();
+  GenericParser parser{kExprConfig, &env};
+
+  auto tables = parser.SerializeTables();
+  auto loaded = GenericParser::LoadTables(tables, &env);
+
+  EXPECT_EQ(loaded->GrammarInfo().Tokens().size(),
+            parser.GrammarInfo().Tokens().size());
+  EXPECT_EQ(loaded->GrammarInfo().Productions().size(),
+            parser.GrammarInfo().Productions().size());
+
+  for (const auto* text : {"1", "1 + 2", "2 * 3 + 4", "2 * (3 + 4)",
+                           "(1 + 2) * (3 + 4) * 5"}) {
+    EXPECT_EQ(Evaluate(*loaded, text), Evaluate(parser, text)) << text;
+  }
+
+  // serialization is deterministic
+  EXPECT_EQ(loaded->SerializeTables(), tables);
+}
+
+TEST(TableFile, NullableGrammar) {
+  GenericParser parser{kNullableConfig, &NullableEnv()};
+
+  auto tables = parser.SerializeTables();
+  auto loaded = GenericParser::LoadTables(tables, &NullableEnv());
+  EXPECT_EQ(loaded->SerializeTables(), tables);
+
+  auto arena = Arena::Create();
+  for (const auto* text : {"a", "abb", "acc", "abbbc"}) {
+    EXPECT_NO_THROW(loaded->Parse(*arena, text)) << text;
+  }
+  EXPECT_THROW(loaded->Parse(*arena, "acb"), ParserInternalError);
+}
+
+TEST(TableFile, LoadWithScanner) {
+  const auto& env = LangProxyManager();
+  const std::string text = kLangSample;
+
+  // tables of a grammar built on the scanner have no lexing table
+  auto direct = CreateParser();
+  auto direct_tables = direct->Compiled()->SerializeTables();
+  EXPECT_THROW(GenericParser::LoadTables(direct_tables, &env),
+               ParserConstructionError);
+
+  ParserOptions options;
+  options.scanner = &ScanToken;
+
+  GenericParser eager{LangConfig(), &env};
+  for (const auto& tables : {direct_tables, eager.SerializeTables()}) {
+    auto loaded = GenericParser::LoadTables(tables, &env, options);
+    EXPECT_EQ(loaded->ActiveLexerMode(), LexerMode::Direct);
+
+    Arena arena;
+    auto* unit = loaded->Parse(arena, text).Extract<TranslationUnit*>();
+    EXPECT_EQ(FunctionNames(unit, text),
+              (std::vector<std::string>{"add", "mul", "main"}));
+  }
+}
+
+TEST(TableFile, LoadMappedFile) {
+  const auto& env = ExprProxyManager();
+  GenericParser parser{kExprConfig, &env};
+
+  auto path = testing::TempDir() + "reggen_table_file.bin";
+  parser.WriteTables(path);
+
+  auto loaded = GenericParser::LoadTableFile(path, &env);
+  EXPECT_EQ(Evaluate(*loaded, "2 * (3 + 4)"), 14);
+
+  std::remove(path.c_str());
+}
+
+TEST(TableFile, RejectCorruptedData) {
+  const auto& env = ExprProxyManager();
+  GenericParser parser{kExprConfig, &env};
+
+  auto tables = parser.SerializeTables();
+
+  auto corrupted = tables;
+  corrupted.back() ^= 1;
+  EXPECT_THROW(GenericParser::LoadTables(corrupted, &env),
+               ParserConstructionError);
+
+  auto truncated = tables.substr(0, tables.size() - 4);
+  EXPECT_THROW(GenericParser::LoadTables(truncated, &env),
+               ParserConstructionError);
+
+  auto wrong_magic = tables;
+  wrong_magic[0] = 'X';
+  EXPECT_THROW(GenericParser::LoadTables(wrong_magic, &env),
+               ParserConstructionError);
+}
+
+}  // namespace
+}  // namespace RG::Test
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RegGen/Common/ThreadPool.h"
+#include "RegGen/RegGenInclude.h"
+
+namespace RG::Test {
+namespace {
+
+// a chunk cut inside a string literal lexes with quotes the wrong way round
+// and never lines up by itself
+constexpr const char* kTokenConfig = R"##(
+token id = "[a-z]+";
+token str = "'[a-z ?]*'";
+
+ignore ws = "[ ]+";
+
+node Item
+{
+    token value;
+}
+
+rule Entry : Item
+    = id:value -> _
+    = str:value -> _
+    ;
+rule Items : Item'vec
+    = -> _
+    = Items! Entry&
+    ;
+)##";
+
+class Item : public AST::BasicASTObject,
+             public AST::DataBundle<AST::BasicASTToken> {};
+
+struct Sample {
+  std::string text;
+  std::vector<AST::BasicASTToken> tokens;
+};
+
+// about size bytes of ids and strings, with tags taken from examples
+auto GenerateSample(int size, const AST::ASTTypeProxyManager& env,
+                    std::mt19937& rng) -> Sample {
+  const CompiledGrammar grammar{kTokenConfig, &env};
+  const auto id_tag = grammar.Tokenize("a")[0].Tag();
+  const auto str_tag = grammar.Tokenize("''")[0].Tag();
+  const auto ws_tag = grammar.Tokenize(" ")[0].Tag();
+
+  Sample result;
+  auto append = [&](const std::string& text, int tag) {
+    result.tokens.emplace_back(result.text.size(), text.size(), tag);
+    result.text += text;
+  };
+
+  std::uniform_int_distribution<int> length{1, 40};
+  while (result.text.size() < size) {
+    std::string text;
+    if (rng() % 3 == 0) {
+      // strings hold spaces and chars no token starts with
+      text = "'";
+      for (int i = length(rng); i > 0; --i) {
+        text += "ab ?"[rng() % 4];
+      }
+      text += "'";
+      append(text, str_tag);
+    } else {
+      for (int i = length(rng) / 4 + 1; i > 0; --i) {
+        text += static_cast<char>('a' + rng() % 26);
+      }
+      append(text, id_tag);
+    }
+
+    append(std::string(rng() % 3 + 1, ' '), ws_tag);
+  }
+
+  return result;
+}
+
+auto SameTokens(const TokenBuffer& lhs,
+                const std::vector<AST::BasicASTToken>& rhs) -> bool {
+  if (lhs.Size() != rhs.size()) {
+    return false;
+  }
+
+  for (int i = 0; i < lhs.Size(); ++i) {
+    if (lhs[i].Offset() != rhs[i].Offset() ||
+        lhs[i].Length() != rhs[i].Length() || lhs[i].Tag() != rhs[i].Tag()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+auto TokenEnv() -> const AST::ASTTypeProxyManager& {
+  static const auto env = [] {
+    AST::ASTTypeProxyManager env;
+    env.RegisterClass<Item>("Item");
+
+    return env;
+  }();
+
+  return env;
+}
+
+TEST(Tokenize, SameAsSerial) {
+  std::mt19937 rng{7};
+  const auto sample = GenerateSample(1 << 21, TokenEnv(), rng);
+
+  for (auto mode : {LexerMode::Eager, LexerMode::Nfa}) {
+    ParserOptions options;
+    options.lexer_mode = mode;
+    const CompiledGrammar grammar{kTokenConfig, &TokenEnv(), options};
+
+    EXPECT_TRUE(SameTokens(grammar.Tokenize(sample.text), sample.tokens));
+    for (auto thread_num : {1, 4}) {
+      ThreadPool pool{thread_num};
+      EXPECT_TRUE(
+          SameTokens(grammar.Tokenize(sample.text, TokenFilter::All, &pool),
+                     sample.tokens))
+          << thread_num;
+    }
+  }
+}
+
+TEST(Tokenize, InvalidToken) {
+  std::mt19937 rng{11};
+  auto sample = GenerateSample(1 << 20, TokenEnv(), rng);
+  const CompiledGrammar grammar{kTokenConfig, &TokenEnv()};
+  ThreadPool pool{4};
+
+  EXPECT_TRUE(grammar.Tokenize("").Empty());
+  EXPECT_THROW(grammar.Tokenize("?"), ParserInternalError);
+
+  // an unmatched char in place of a space between tokens, far into the input
+  auto& text = sample.text;
+  for (auto i = sample.tokens.size() * 3 / 4;; ++i) {
+    if (const auto& tok = sample.tokens[i]; text[tok.Offset()] == ' ') {
+      text[tok.Offset()] = '?';
+      break;
+    }
+  }
+
+  EXPECT_THROW(grammar.Tokenize(text), ParserInternalError);
+  EXPECT_THROW(grammar.Tokenize(text, TokenFilter::All, &pool),
+               ParserInternalError);
+}
+
+TEST(Tokenize, Significant) {
+  std::mt19937 rng{13};
+  const auto sample = GenerateSample(1 << 20, TokenEnv(), rng);
+  const CompiledGrammar grammar{kTokenConfig, &TokenEnv()};
+  ThreadPool pool{4};
+
+  const auto ws_tag = grammar.Tokenize(" ")[0].Tag();
+  std::vector<AST::BasicASTToken> expected;
+  std::copy_if(sample.tokens.begin(), sample.tokens.end(),
+               std::back_inserter(expected),
+               [&](const auto& tok) { return tok.Tag() != ws_tag; });
+
+  EXPECT_TRUE(SameTokens(
+      grammar.Tokenize(sample.text, TokenFilter::Significant), expected));
+  EXPECT_TRUE(SameTokens(
+      grammar.Tokenize(sample.text, TokenFilter::Significant, &pool),
+      expected));
+
+  // the handle forwards the pool as well
+  const GenericParser parser{kTokenConfig, &TokenEnv()};
+  EXPECT_TRUE(SameTokens(
+      parser.Tokenize(sample.text, TokenFilter::Significant, &pool),
+      expected));
+}
+
+TEST(Tokenize, NulInToken) {
+  // a nul may be part of a string, so the end of input is checked instead
+  constexpr const char* config = R"##(
+    token str = "'[^']*'";
+    ignore ws = "[ ]+";
+
+    node Item
+    {
+        token value;
+    }
+
+    rule Entry : Item
+        = str:value -> _
+        ;
+    rule Items : Item'vec
+        = -> _
+        = Items! Entry&
+        ;
+  )##";
+  const CompiledGrammar grammar{config, &TokenEnv()};
+
+  const auto tokens = grammar.Tokenize(std::string{"'a\0b' ''", 8});
+  ASSERT_EQ(tokens.Size(), 3);
+  EXPECT_EQ(tokens[0].Length(), 5);
+  EXPECT_EQ(tokens[2].Offset(), 6);
+
+  // the nul after the input must not close the string
+  EXPECT_THROW(grammar.Tokenize("'ab"), ParserInternalError);
+}
+
+TEST(Tokenize, ParsePrebuilt) {
+  std::mt19937 rng{17};
+  const auto sample = GenerateSample(1 << 16, TokenEnv(), rng);
+  const CompiledGrammar grammar{kTokenConfig, &TokenEnv()};
+  auto arena = Arena::Create();
+
+  // ignored tokens in the buffer are skipped as in Parse on the text
+  for (auto filter : {TokenFilter::All, TokenFilter::Significant}) {
+    auto result = grammar.Parse(*arena, grammar.Tokenize(sample.text, filter));
+    const auto* items = result.Extract<AST::ASTVector<Item*>*>();
+
+    ASSERT_EQ(items->Size(), sample.tokens.size() / 2);
+    EXPECT_EQ(items->Value().back()->GetItem<0>().Offset(),
+              sample.tokens[sample.tokens.size() - 2].Offset());
+  }
+
+  TokenBuffer invalid;
+  invalid.Append(AST::BasicASTToken{});
+  EXPECT_THROW(grammar.Parse(*arena, invalid), ParserInternalError);
+}
+
+}  // namespace
+}  // namespace RG::Test